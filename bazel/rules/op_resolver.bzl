@@ -0,0 +1,81 @@
+""" Model specific (reduced) TFLite Op Resolver """
+
+def tflite_op_resolver(name, model, **kwargs):
+    """ Generates op resolver which registers only the ops used by the given model.
+
+    Provides `perception::CreateOpResolver()` (see lib/include/perception/op_resolver/op_resolver.h), thus link it
+    instead of //lib:builtin_op_resolver.
+
+    Args:
+        name: name of the cc_library
+        model: label of the .tflite model (single file)
+        **kwargs: passed to cc_library
+    """
+    native.genrule(
+        name = name + "_registration",
+        srcs = [model],
+        outs = [name + "_registration.cc"],
+        cmd = "$(location @org_tensorflow//tensorflow/lite/tools:generate_op_registrations) " +
+              "--input_model=$(location " + model + ") " +
+              "--output_registration=$@ " +
+              "--tflite_path=tensorflow/lite",
+        tools = ["@org_tensorflow//tensorflow/lite/tools:generate_op_registrations"],
+    )
+
+    native.cc_library(
+        name = name,
+        srcs = [
+            name + "_registration.cc",
+            "//lib:src/op_resolver/selected_op_resolver.cpp",
+        ],
+        deps = [
+            "//lib:op_resolver",
+            "@org_tensorflow//tensorflow/lite:framework",
+            "@org_tensorflow//tensorflow/lite/kernels:builtin_op_kernels",
+        ],
+        **kwargs
+    )
+
+def label_image_for_model(name, model, full_binary = "//:label_image"):
+    """ Generates `label_image_<name>` linked against op resolver reduced to the given model, along with
+    `label_image_<name>_report`, which reports binary size and cold-start time against the full op resolver.
+
+    Args:
+        name: model name
+        model: label of the .tflite model (single file)
+        full_binary: label_image target linked against //lib:builtin_op_resolver
+    """
+    binary = "label_image_" + name
+    tflite_op_resolver(
+        name = name + "_op_resolver",
+        model = model,
+    )
+
+    native.cc_binary(
+        name = binary,
+        srcs = ["//:src/main.cpp"],
+        data = [
+            "//:testdata",
+            model,
+        ],
+        deps = [
+            ":" + name + "_op_resolver",
+            "//lib:perception",
+        ],
+    )
+
+    native.sh_binary(
+        name = binary + "_report",
+        srcs = ["//tools:op_resolver_report.sh"],
+        args = [
+            "$(location " + full_binary + ")",
+            "$(location :" + binary + ")",
+            "$(location " + model + ")",
+        ],
+        data = [
+            ":" + binary,
+            "//:testdata",
+            full_binary,
+            model,
+        ],
+    )
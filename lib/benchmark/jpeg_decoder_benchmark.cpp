@@ -0,0 +1,192 @@
+///
+/// @file jpeg_decoder_benchmark.cpp
+/// @brief Benchmarks JPG Decoder for each kernel set (IDCT, upsampling and color conversion; scalar, SSE2, AVX2),
+///        each DCT domain scale (1/2 - 1/8), parallel decode (restart intervals, color conversion), region of
+///        interest decode (center crop), decoder reuse (arena buffers) and luma only decode
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+/// Usage: jpeg_decoder_benchmark [iterations] [image.jpg ...]
+///
+/// i.e. jpeg_decoder_benchmark 20 data/grace_hopper.jpg 1080p.jpg 4k.jpg
+///
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "perception/image_helper/jpeg_decoder.h"
+#include "perception/utils/arena.h"
+#include "perception/utils/mapped_file.h"
+#include "perception/utils/thread_pool.h"
+
+namespace
+{
+/// @brief Runs given function for number of iterations
+/// @return average time per iteration (ms)
+template <typename Function>
+double MeasureAverageTime(const std::int32_t iterations, Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::int32_t i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const std::int32_t iterations = (argc > 1) ? std::atoi(argv[1]) : 20;
+    std::vector<std::string> image_paths{"data/grace_hopper.jpg"};
+    if (argc > 2)
+    {
+        image_paths.assign(argv + 2, argv + argc);
+    }
+
+    using perception::InstructionSet;
+    for (const auto& image_path : image_paths)
+    {
+        const perception::MappedFile jpeg_file{image_path};
+        const auto data = reinterpret_cast<const char*>(jpeg_file.GetData());
+
+        // scalar output is the reference for bit-exactness
+        const auto reference = std::make_unique<Jpeg::Decoder>(data, jpeg_file.GetSize(), malloc, free,
+                                                               InstructionSet::kScalar);
+        if (reference->GetResult() != Jpeg::Decoder::OK)
+        {
+            std::cerr << "Failed to decode " << image_path << " (error " << reference->GetResult() << ")\n";
+            return 1;
+        }
+        const auto megapixels = reference->GetWidth() * reference->GetHeight() / 1e6;
+        std::cout << "image: " << image_path << " (" << reference->GetWidth() << "x" << reference->GetHeight()
+                  << "), iterations: " << iterations << "\n";
+
+        double scalar_ms = 0.0;
+        for (const auto instruction_set : {InstructionSet::kScalar, InstructionSet::kSse2, InstructionSet::kAvx2})
+        {
+            if (instruction_set > perception::GetSupportedInstructionSet())
+            {
+                continue;
+            }
+            std::unique_ptr<Jpeg::Decoder> decoder;
+            const auto decode_ms = MeasureAverageTime(iterations, [&]() {
+                decoder = std::make_unique<Jpeg::Decoder>(data, jpeg_file.GetSize(), malloc, free, instruction_set);
+            });
+            if (instruction_set == InstructionSet::kScalar)
+            {
+                scalar_ms = decode_ms;
+            }
+
+            const auto bit_exact = (decoder->GetImageSize() == reference->GetImageSize()) &&
+                                   (std::memcmp(decoder->GetImage(), reference->GetImage(),
+                                                reference->GetImageSize()) == 0);
+            std::cout << "decode (instruction set " << static_cast<std::int32_t>(instruction_set)
+                      << "): " << decode_ms << " ms, " << megapixels / (decode_ms / 1e3) << " MP/s (speedup x"
+                      << scalar_ms / decode_ms << ", " << (bit_exact ? "bit-exact" : "MISMATCH") << ")\n";
+        }
+
+        {
+            perception::Arena arena;
+            Jpeg::Decoder decoder{malloc, free, perception::GetSupportedInstructionSet(), &arena};
+            const auto decode_ms = MeasureAverageTime(iterations, [&]() {
+                arena.Reset();
+                decoder.Decode(data, jpeg_file.GetSize());
+            });
+            const auto bit_exact = (decoder.GetImageSize() == reference->GetImageSize()) &&
+                                   (std::memcmp(decoder.GetImage(), reference->GetImage(),
+                                                reference->GetImageSize()) == 0);
+            std::cout << "decode (reused decoder, " << arena.GetNumberOfHeapAllocations()
+                      << " heap allocations): " << decode_ms << " ms (speedup x" << scalar_ms / decode_ms << ", "
+                      << (bit_exact ? "bit-exact" : "MISMATCH") << ")\n";
+        }
+
+        for (std::int32_t scale_shift = 1; scale_shift <= 3; ++scale_shift)
+        {
+            // minimum size which selects given scale
+            const auto minimum_width = reference->GetWidth() >> scale_shift;
+            const auto minimum_height = reference->GetHeight() >> scale_shift;
+            Jpeg::Decoder::DecodeOptions options;
+            options.minWidth = minimum_width;
+            options.minHeight = minimum_height;
+            std::unique_ptr<Jpeg::Decoder> decoder;
+            const auto decode_ms = MeasureAverageTime(iterations, [&]() {
+                decoder = std::make_unique<Jpeg::Decoder>(data, jpeg_file.GetSize(), malloc, free,
+                                                          perception::GetSupportedInstructionSet(), options);
+            });
+            std::cout << "decode (scale 1/" << (1 << decoder->GetScaleShift()) << ", " << decoder->GetWidth() << "x"
+                      << decoder->GetHeight() << "): " << decode_ms << " ms (speedup x" << scalar_ms / decode_ms
+                      << ")\n";
+        }
+
+        for (std::size_t number_of_threads = 2U; number_of_threads <= std::thread::hardware_concurrency();
+             number_of_threads <<= 1U)
+        {
+            perception::ThreadPool thread_pool{number_of_threads};
+            Jpeg::Decoder::DecodeOptions options;
+            options.threadPool = &thread_pool;
+            std::unique_ptr<Jpeg::Decoder> decoder;
+            const auto decode_ms = MeasureAverageTime(iterations, [&]() {
+                decoder = std::make_unique<Jpeg::Decoder>(data, jpeg_file.GetSize(), malloc, free,
+                                                          perception::GetSupportedInstructionSet(), options);
+            });
+            const auto bit_exact = (decoder->GetImageSize() == reference->GetImageSize()) &&
+                                   (std::memcmp(decoder->GetImage(), reference->GetImage(),
+                                                reference->GetImageSize()) == 0);
+            std::cout << "decode (" << number_of_threads << " threads): " << decode_ms << " ms (speedup x"
+                      << scalar_ms / decode_ms << ", " << (bit_exact ? "bit-exact" : "MISMATCH") << ")\n";
+        }
+
+        for (const auto fraction : {0.875, 0.5, 0.25})
+        {
+            // center crop, i.e. central_fraction of TF image preprocessing
+            const auto crop_width = static_cast<std::int32_t>(reference->GetWidth() * fraction);
+            const auto crop_height = static_cast<std::int32_t>(reference->GetHeight() * fraction);
+            const auto crop_x = (reference->GetWidth() - crop_width) / 2;
+            const auto crop_y = (reference->GetHeight() - crop_height) / 2;
+            Jpeg::Decoder::DecodeOptions options;
+            options.cropX = crop_x;
+            options.cropY = crop_y;
+            options.cropWidth = crop_width;
+            options.cropHeight = crop_height;
+            std::unique_ptr<Jpeg::Decoder> decoder;
+            const auto decode_ms = MeasureAverageTime(iterations, [&]() {
+                decoder = std::make_unique<Jpeg::Decoder>(data, jpeg_file.GetSize(), malloc, free,
+                                                          perception::GetSupportedInstructionSet(), options);
+            });
+            auto bit_exact = (decoder->GetWidth() == crop_width) && (decoder->GetHeight() == crop_height);
+            const auto channels = decoder->IsColor() ? 3 : 1;
+            for (std::int32_t row = 0; bit_exact && (row < crop_height); ++row)
+            {
+                bit_exact = std::memcmp(&decoder->GetImage()[row * crop_width * channels],
+                                        &reference->GetImage()[((crop_y + row) * reference->GetWidth() + crop_x) *
+                                                               channels],
+                                        crop_width * channels) == 0;
+            }
+            std::cout << "decode (center crop " << fraction << ", " << crop_width << "x" << crop_height
+                      << "): " << decode_ms << " ms (speedup x" << scalar_ms / decode_ms << ", "
+                      << (bit_exact ? "bit-exact" : "MISMATCH") << ")\n";
+        }
+
+        if (reference->IsColor())
+        {
+            Jpeg::Decoder::DecodeOptions options;
+            options.lumaOnly = true;
+            std::unique_ptr<Jpeg::Decoder> decoder;
+            const auto decode_ms = MeasureAverageTime(iterations, [&]() {
+                decoder = std::make_unique<Jpeg::Decoder>(data, jpeg_file.GetSize(), malloc, free,
+                                                          perception::GetSupportedInstructionSet(), options);
+            });
+            std::cout << "decode (luma only, " << decoder->GetImageSize() << " bytes): " << decode_ms
+                      << " ms (speedup x" << scalar_ms / decode_ms << ")\n";
+        }
+    }
+    return 0;
+}
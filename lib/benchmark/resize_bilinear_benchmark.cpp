@@ -0,0 +1,163 @@
+///
+/// @file resize_bilinear_benchmark.cpp
+/// @brief Benchmarks native BilinearResizer against TFLite RESIZE_BILINEAR based preprocessing
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+/// Usage: resize_bilinear_benchmark [image.bmp|image.jpg] [iterations]
+///
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "tensorflow/lite/builtin_op_data.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/kernels/register.h"
+
+#include "perception/image_helper/bitmap_helper.h"
+#include "perception/image_helper/jpeg_helper.h"
+#include "perception/utils/resize_bilinear.h"
+
+namespace
+{
+/// @brief MobileNetV2 input
+constexpr std::int32_t kWantedHeight = 224;
+constexpr std::int32_t kWantedWidth = 224;
+constexpr std::int32_t kWantedChannels = 3;
+constexpr float kInputMean = 127.5F;
+constexpr float kInputStd = 127.5F;
+
+/// @brief Builds TFLite resize interpreter (i.e. preprocessing path prior to BilinearResizer)
+std::unique_ptr<tflite::Interpreter> BuildResizeInterpreter(const std::int32_t height, const std::int32_t width,
+                                                            const std::int32_t channels)
+{
+    auto interpreter = std::make_unique<tflite::Interpreter>();
+    std::int32_t base_index = 0;
+    interpreter->AddTensors(3, &base_index);
+    interpreter->SetInputs({0, 1});
+    interpreter->SetOutputs({2});
+
+    TfLiteQuantizationParams quant{};
+    interpreter->SetTensorParametersReadWrite(0, kTfLiteFloat32, "input", {1, height, width, channels}, quant);
+    interpreter->SetTensorParametersReadWrite(1, kTfLiteInt32, "new_size", {2}, quant);
+    interpreter->SetTensorParametersReadWrite(2, kTfLiteFloat32, "output",
+                                              {1, kWantedHeight, kWantedWidth, kWantedChannels}, quant);
+
+    tflite::ops::builtin::BuiltinOpResolver resolver;
+    const TfLiteRegistration* resize_op = resolver.FindOp(tflite::BuiltinOperator_RESIZE_BILINEAR, 1);
+    auto* params = reinterpret_cast<TfLiteResizeBilinearParams*>(malloc(sizeof(TfLiteResizeBilinearParams)));
+    params->align_corners = false;
+    interpreter->AddNodeWithParameters({0, 1}, {2}, nullptr, 0, params, resize_op, nullptr);
+    interpreter->AllocateTensors();
+
+    interpreter->typed_tensor<std::int32_t>(1)[0] = kWantedHeight;
+    interpreter->typed_tensor<std::int32_t>(1)[1] = kWantedWidth;
+    return interpreter;
+}
+
+/// @brief uint8 -> float, RESIZE_BILINEAR, then normalization pass
+void ResizeWithTFLite(tflite::Interpreter* interpreter, const std::vector<std::uint8_t>& image, float* output)
+{
+    auto input = interpreter->typed_tensor<float>(0);
+    for (std::size_t i = 0; i < image.size(); ++i)
+    {
+        input[i] = image[i];
+    }
+    interpreter->Invoke();
+    const auto resized = interpreter->typed_tensor<float>(2);
+    for (std::int32_t i = 0; i < kWantedHeight * kWantedWidth * kWantedChannels; ++i)
+    {
+        output[i] = (resized[i] - kInputMean) / kInputStd;
+    }
+}
+
+/// @brief Runs given function for number of iterations
+/// @return average time per iteration (ms)
+template <typename Function>
+double MeasureAverageTime(const std::int32_t iterations, Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::int32_t i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const std::string image_path = (argc > 1) ? argv[1] : "data/grace_hopper.bmp";
+    const std::int32_t iterations = (argc > 2) ? std::atoi(argv[2]) : 100;
+
+    std::unique_ptr<perception::IImageHelper> image_helper;
+    if (absl::EndsWith(image_path, ".bmp"))
+    {
+        image_helper = std::make_unique<perception::BitmapImageHelper>();
+    }
+    else
+    {
+        image_helper = std::make_unique<perception::JpegImageHelper>();
+    }
+    std::int32_t width = 0;
+    std::int32_t height = 0;
+    std::int32_t channels = 0;
+    const auto image = image_helper->ReadImage(image_path, &width, &height, &channels);
+
+    std::vector<float> expected(kWantedHeight * kWantedWidth * kWantedChannels);
+    std::vector<float> actual(expected.size());
+
+    const auto tflite_per_frame_ms = MeasureAverageTime(iterations, [&]() {
+        auto interpreter = BuildResizeInterpreter(height, width, channels);
+        ResizeWithTFLite(interpreter.get(), image, expected.data());
+    });
+
+    auto interpreter = BuildResizeInterpreter(height, width, channels);
+    const auto tflite_cached_ms =
+        MeasureAverageTime(iterations, [&]() { ResizeWithTFLite(interpreter.get(), image, expected.data()); });
+
+    std::cout << "image: " << image_path << " (" << width << "x" << height << "x" << channels << ") -> "
+              << kWantedWidth << "x" << kWantedHeight << "x" << kWantedChannels << ", iterations: " << iterations
+              << "\n";
+    std::cout << "tflite RESIZE_BILINEAR (interpreter per frame): " << tflite_per_frame_ms << " ms\n";
+    std::cout << "tflite RESIZE_BILINEAR (cached interpreter):    " << tflite_cached_ms << " ms\n";
+
+    using perception::InstructionSet;
+    for (const auto instruction_set :
+         {InstructionSet::kScalar, InstructionSet::kSse2, InstructionSet::kSse41, InstructionSet::kAvx2})
+    {
+        if (instruction_set > perception::GetSupportedInstructionSet())
+        {
+            continue;
+        }
+        perception::BilinearResizer resizer{height,       width,           channels,       kWantedHeight,
+                                            kWantedWidth, kWantedChannels, instruction_set};
+        const auto native_ms = MeasureAverageTime(iterations, [&]() {
+            resizer.Resize(image.data(), 1.0F / kInputStd, -kInputMean / kInputStd, actual.data());
+        });
+
+        float max_error = 0.0F;
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            max_error = std::max(max_error, std::fabs(expected[i] - actual[i]));
+        }
+        std::cout << "native BilinearResizer (instruction set " << static_cast<std::int32_t>(instruction_set)
+                  << "):     " << native_ms << " ms (speedup x" << tflite_cached_ms / native_ms
+                  << ", max abs error " << max_error << ")\n";
+
+        std::vector<std::uint8_t> quantized(expected.size());
+        const auto fixed_point_ms =
+            MeasureAverageTime(iterations, [&]() { resizer.Resize(image.data(), quantized.data()); });
+        std::cout << "native BilinearResizer fixed-point uint8 (instruction set "
+                  << static_cast<std::int32_t>(instruction_set) << "): " << fixed_point_ms << " ms\n";
+    }
+    return 0;
+}
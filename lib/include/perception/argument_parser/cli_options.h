@@ -58,6 +58,42 @@ struct CLIOptions
 
     /// @brief Enable/Disable for saving results
     bool save_results = false;
+
+    /// @brief Enable/Disable Benchmark Mode (per-stage latency statistics over loop_count iterations)
+    bool benchmark = false;
+
+    /// @brief Number of warmup iterations, excluded from benchmark statistics
+    std::int32_t warmup_runs = 1;
+
+    /// @brief Enable/Disable Pipeline Mode, i.e. loop_count frames stream through concurrent decode, preprocess,
+    ///        invoke and postprocess stages
+    bool pipeline = false;
+
+    /// @brief Delegate to be applied to the interpreter (registered in DelegateRegistry, i.e. "none", "nnapi")
+    std::string delegate = "none";
+
+    /// @brief Number of threads to be used for JPEG decode (restart intervals and color conversion)
+    std::int32_t decode_threads = 1;
+
+    /// @brief Region of interest within input image (x, y, width, height in pixels), read and classified instead of
+    ///        the whole image [0 width/height for whole image]
+    std::int32_t roi_x = 0;
+    std::int32_t roi_y = 0;
+    std::int32_t roi_width = 0;
+    std::int32_t roi_height = 0;
+
+    /// @brief Size of input cache in MB, i.e. preprocessed Model Inputs of repeated images [0 to disable]
+    std::int32_t input_cache_mb = 64;
+
+    /// @brief Directory or manifest file (one image path per line) of images to classify in batch mode [empty to
+    ///        classify input image only]
+    std::string batch_input = "";
+
+    /// @brief Number of worker threads (each with its own interpreter) in batch mode
+    std::int32_t batch_workers = 4;
+
+    /// @brief Batch mode results file within result directory, JSON Lines or CSV (by extension)
+    std::string batch_output = "batch_results.jsonl";
 };
 
 }  // namespace perception
@@ -6,11 +6,14 @@
 #ifndef PERCEPTION_IMAGE_HELPER_BITMAP_HELPER_H_
 #define PERCEPTION_IMAGE_HELPER_BITMAP_HELPER_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 
+#include "perception/image_helper/bitmap_swizzle.h"
 #include "perception/image_helper/i_image_helper.h"
+#include "perception/utils/mapped_file.h"
 
 namespace perception
 {
@@ -32,10 +35,67 @@ class BitmapImageHelper : public IImageHelper
     virtual std::vector<std::uint8_t> ReadImage(const std::string& image_path, std::int32_t* width,
                                                 std::int32_t* height, std::int32_t* channels) override;
 
+    /// @brief Read Bitmap (BMP) Image file straight into caller provided buffer, i.e. without intermediate copy.
+    /// @param [in] image_path - Path to BMP Image
+    /// @param [out] output - Image Data, at least width * height * channels bytes (see Probe())
+    /// @param [in] output_size - Size of output in bytes
+    /// @param [out] width - Image Width
+    /// @param [out] height - Image Height
+    /// @param [out] channels - Image Channels
+    /// @throws std::runtime_error if output is too small for the image (resp. region of interest)
+    void ReadImage(const std::string& image_path, std::uint8_t* output, const std::size_t output_size,
+                   std::int32_t* width, std::int32_t* height, std::int32_t* channels);
+
+    /// @brief Read Bitmap (BMP) properties from file header.
+    /// @param [in] image_path - Path to BMP Image
+    /// @return info - Image Format, Size and Channels
+    virtual ImageInfo Probe(const std::string& image_path) const override;
+
+    /// @brief Read Bitmap (BMP) Image file, keeping decoded image within the helper.
+    /// @param [in] image_path - Path to BMP Image
+    /// @param [out] width - Image Width
+    /// @param [out] height - Image Height
+    /// @param [out] channels - Image Channels
+    /// @return data - Image Data, valid until the next read (or destruction)
+    virtual const std::uint8_t* ReadImageView(const std::string& image_path, std::int32_t* width,
+                                              std::int32_t* height, std::int32_t* channels) override;
+
+    /// @brief Set minimum size of decoded images, ignored as BMP is always read at full size.
+    virtual void SetMinimumSize(const std::int32_t width, const std::int32_t height) override;
+
+    /// @brief Set number of threads used to decode single image, ignored as BMP is read serially.
+    virtual void SetNumberOfThreads(const std::int32_t number_of_threads) override;
+
+    /// @brief Set region of interest, only pixels within it are copied out of the BMP.
+    /// @param [in] x - Left of Region (pixels)
+    /// @param [in] y - Top of Region (pixels)
+    /// @param [in] width - Region Width (0 for whole image)
+    /// @param [in] height - Region Height (0 for whole image)
+    virtual void SetRegionOfInterest(const std::int32_t x, const std::int32_t y, const std::int32_t width,
+                                     const std::int32_t height) override;
+
+    /// @brief Set luma only read, ignored as BMP pixels are stored interleaved (i.e. no separate luma to read).
+    virtual void SetLumaOnly(const bool luma_only) override;
+
   private:
+    /// @brief Reads header of mapped BMP (rejects dimensions, whose pixels are not within the file) and clips region
+    ///        of interest to the image
+    /// @return bmp_pixels - Pixel array within mapped BMP
+    const std::uint8_t* ReadHeader(const MappedFile& bmp_file, const std::string& image_path);
+
+    /// @brief Provides dimensions of decoded image (region of interest), read by last ReadHeader()
+    void GetRegionDimensions(std::int32_t* width, std::int32_t* height, std::int32_t* channels) const;
+
+    /// @brief Provides size of decoded image (region of interest) in bytes
+    std::size_t GetImageSize() const;
+
     /// @brief Decodes Image Data from given data buffer
     virtual std::vector<std::uint8_t> DecodeImage(const std::uint8_t* input) const override;
 
+    /// @brief Decodes Image Data from given data buffer into output, i.e. flips rows (bottom up BMP) and swaps
+    ///        BGR(A) to RGB(A) one row at a time
+    void DecodeImage(const std::uint8_t* input, std::uint8_t* output) const;
+
     /// @brief Image Width
     std::int32_t width_;
 
@@ -44,6 +104,27 @@ class BitmapImageHelper : public IImageHelper
 
     /// @brief Image Channels
     std::int32_t channels_;
+
+    /// @brief Region of Interest (0 width/height for whole image)
+    std::int32_t roi_x_;
+    std::int32_t roi_y_;
+    std::int32_t roi_width_;
+    std::int32_t roi_height_;
+
+    /// @brief Region of Interest clipped to current image, i.e. decoded region
+    std::int32_t region_x_;
+    std::int32_t region_y_;
+    std::int32_t region_width_;
+    std::int32_t region_height_;
+
+    /// @brief Size of BMP row in bytes, incl. padding to a multiple of 4 bytes
+    std::size_t row_size_;
+
+    /// @brief Swizzle kernels (BGR(A) to RGB(A)) of best supported instruction set
+    BitmapKernels kernels_;
+
+    /// @brief Last decoded image (see ReadImageView)
+    std::vector<std::uint8_t> image_;
 };
 }  // namespace perception
 #endif  /// PERCEPTION_IMAGE_HELPER_BITMAP_HELPER_H_
\ No newline at end of file
@@ -0,0 +1,38 @@
+///
+/// @file bitmap_swizzle.h
+/// @brief Contains BGR(A) to RGB(A) row kernels used by Bitmap Image Helper
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_IMAGE_HELPER_BITMAP_SWIZZLE_H_
+#define PERCEPTION_IMAGE_HELPER_BITMAP_SWIZZLE_H_
+
+#include <cstdint>
+
+#include "perception/utils/cpu_features.h"
+
+namespace perception
+{
+/// @brief Signature of swizzle kernels, i.e. swap of first and third channel of each pixel
+/// @param [in] input - Input row (BGR resp. BGRA)
+/// @param [in] width - Row width (pixels)
+/// @param [out] output - Output row (RGB resp. RGBA), must not overlap with input
+using SwizzleRowFunction = void (*)(const std::uint8_t* input, const std::int32_t width, std::uint8_t* output);
+
+/// @brief Swizzle kernels for single instruction set
+struct BitmapKernels
+{
+    SwizzleRowFunction bgr_to_rgb;
+    SwizzleRowFunction bgra_to_rgba;
+};
+
+/// @brief Provides swizzle kernels for given instruction set.
+///
+/// SSSE3 kernels shuffle 5 (BGR) resp. 4 (BGRA) pixels per pshufb, AVX2 kernels 8 pixels (BGR lanes are packed by
+/// vpermd). Neither loads nor stores beyond the given rows, remaining pixels are swapped by scalar code.
+///
+/// @param [in] instruction_set - Instruction set to be used (defaults to best supported)
+BitmapKernels GetBitmapKernels(const InstructionSet instruction_set = GetSupportedInstructionSet());
+
+}  // namespace perception
+
+#endif  // PERCEPTION_IMAGE_HELPER_BITMAP_SWIZZLE_H_
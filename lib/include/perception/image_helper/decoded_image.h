@@ -0,0 +1,48 @@
+///
+/// @file decoded_image.h
+/// @brief Contains Decoded Image and Region of Interest definitions
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_IMAGE_HELPER_DECODED_IMAGE_H_
+#define PERCEPTION_IMAGE_HELPER_DECODED_IMAGE_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace perception
+{
+/// @brief Decoded Image (HWC, uint8) along with its dimensions
+struct DecodedImage
+{
+    /// @brief Image Data
+    std::vector<std::uint8_t> data;
+
+    /// @brief Image Width
+    std::int32_t width;
+
+    /// @brief Image Height
+    std::int32_t height;
+
+    /// @brief Image Channels
+    std::int32_t channels;
+};
+
+/// @brief Region of interest within image (full size pixels), see IImageHelper::SetRegionOfInterest()
+struct RegionOfInterest
+{
+    /// @brief Left of Region
+    std::int32_t x;
+
+    /// @brief Top of Region
+    std::int32_t y;
+
+    /// @brief Region Width (0 for whole image)
+    std::int32_t width;
+
+    /// @brief Region Height (0 for whole image)
+    std::int32_t height;
+};
+
+}  // namespace perception
+
+#endif  /// PERCEPTION_IMAGE_HELPER_DECODED_IMAGE_H_
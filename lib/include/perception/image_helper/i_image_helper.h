@@ -12,6 +12,32 @@
 
 namespace perception
 {
+/// @brief Image File Formats
+enum class ImageFormat : std::int32_t
+{
+    kInvalid = 0,
+    kBitmap = 1,
+    kJpeg = 2
+};
+
+/// @brief Image properties read from file header (see IImageHelper::Probe)
+struct ImageInfo
+{
+    /// @brief Image Format
+    ImageFormat format;
+
+    /// @brief Image Width/Height (full size, i.e. before minimum size and region of interest are applied)
+    std::int32_t width;
+    std::int32_t height;
+
+    /// @brief Image Channels (as read by ReadImage, i.e. after luma only is applied)
+    std::int32_t channels;
+
+    /// @brief Chroma subsampling factors (i.e. 2x2 for 4:2:0, 2x1 for 4:2:2), 1x1 without subsampling
+    std::int32_t horizontal_subsampling;
+    std::int32_t vertical_subsampling;
+};
+
 class IImageHelper
 {
   public:
@@ -27,6 +53,45 @@ class IImageHelper
     virtual std::vector<std::uint8_t> ReadImage(const std::string& image_path, std::int32_t* width,
                                                 std::int32_t* height, std::int32_t* channels) = 0;
 
+    /// @brief Read image properties from file header, without decoding the image.
+    /// @param [in] image_path - Path to Image
+    /// @return info - Image Format, Size, Channels and Subsampling
+    virtual ImageInfo Probe(const std::string& image_path) const = 0;
+
+    /// @brief Read Image file, without copying decoded image to the caller.
+    /// @param [in] image_path - Path to Image
+    /// @param [out] width - Image Width
+    /// @param [out] height - Image Height
+    /// @param [out] channels - Image Channels
+    /// @return data - Image Data, owned by the helper and valid until the next read (or destruction)
+    virtual const std::uint8_t* ReadImageView(const std::string& image_path, std::int32_t* width,
+                                              std::int32_t* height, std::int32_t* channels) = 0;
+
+    /// @brief Set minimum size of decoded images (i.e. model input size). Helpers which can decode at reduced size
+    ///        (JPG) use the smallest supported size not below it, others ignore it.
+    /// @param [in] width - Minimum Image Width (0 for full size)
+    /// @param [in] height - Minimum Image Height (0 for full size)
+    virtual void SetMinimumSize(const std::int32_t width, const std::int32_t height) = 0;
+
+    /// @brief Set number of threads used to decode single image. Helpers which can decode in parallel (JPG) use
+    ///        them, others ignore it.
+    /// @param [in] number_of_threads - Number of Threads (1 for serial decode)
+    virtual void SetNumberOfThreads(const std::int32_t number_of_threads) = 0;
+
+    /// @brief Set region of interest, i.e. only this rectangle of the images is read (clipped to the image).
+    ///        Helpers which can skip the rest (JPG) do not decode it.
+    /// @param [in] x - Left of Region (full size pixels)
+    /// @param [in] y - Top of Region (full size pixels)
+    /// @param [in] width - Region Width (0 for whole image)
+    /// @param [in] height - Region Height (0 for whole image)
+    virtual void SetRegionOfInterest(const std::int32_t x, const std::int32_t y, const std::int32_t width,
+                                     const std::int32_t height) = 0;
+
+    /// @brief Set luma only read (i.e. single channel model input). Helpers which can skip chroma (JPG) read color
+    ///        images as single channel luma, others ignore it and keep reading them in color.
+    /// @param [in] luma_only - Read luma only (false for color)
+    virtual void SetLumaOnly(const bool luma_only) = 0;
+
   private:
     /// @brief Decodes Image Data from given data buffer
     virtual std::vector<std::uint8_t> DecodeImage(const std::uint8_t* input_data) const = 0;
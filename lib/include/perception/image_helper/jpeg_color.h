@@ -0,0 +1,71 @@
+///
+/// @file jpeg_color.h
+/// @brief Contains chroma upsampling and YCbCr to RGB kernels used by JPG Decoder
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_IMAGE_HELPER_JPEG_COLOR_H_
+#define PERCEPTION_IMAGE_HELPER_JPEG_COLOR_H_
+
+#include <cstdint>
+
+#include "perception/utils/cpu_features.h"
+
+namespace perception
+{
+/// @brief Taps of 2x upsampling filter (NanoJPEG's 4-tap filter, with 2 and 3 taps near the edges)
+struct UpsampleTaps
+{
+    /// @brief Input sample indices, unused taps point to a valid sample
+    std::int32_t index[4];
+
+    /// @brief Weights (sum up to 128), unused taps are 0
+    std::int16_t weight[4];
+};
+
+/// @brief Provides taps of 2x upsampling filter for single output sample
+/// @param [in] output_index - Output sample index [0, 2 * input_size)
+/// @param [in] input_size - Number of input samples (at least 3)
+UpsampleTaps GetUpsampleTaps(const std::int32_t output_index, const std::int32_t input_size);
+
+/// @brief Signature of horizontal 2x upsampling kernels
+/// @param [in] input - Input row
+/// @param [in] input_width - Input row width (at least 3)
+/// @param [out] output - Output row (2 * input_width)
+using UpsampleRowFunction = void (*)(const std::uint8_t* input, const std::int32_t input_width, std::uint8_t* output);
+
+/// @brief Signature of vertical filter kernels, i.e. output = clip((sum(weights[i] * rows[i]) + 64) >> 7)
+/// @param [in] rows - 4 input rows (see UpsampleTaps)
+/// @param [in] weights - 4 weights (see UpsampleTaps)
+/// @param [in] width - Row width
+/// @param [out] output - Output row
+using FilterRowsFunction = void (*)(const std::uint8_t* const* rows, const std::int16_t* weights,
+                                    const std::int32_t width, std::uint8_t* output);
+
+/// @brief Signature of YCbCr to RGB kernels (JFIF, 8-bit fixed point)
+/// @param [in] y - Luma row
+/// @param [in] cb - Blue-difference chroma row
+/// @param [in] cr - Red-difference chroma row
+/// @param [in] width - Row width
+/// @param [out] rgb - Interleaved R, G, B row (3 * width)
+using ConvertRowFunction = void (*)(const std::uint8_t* y, const std::uint8_t* cb, const std::uint8_t* cr,
+                                    const std::int32_t width, std::uint8_t* rgb);
+
+/// @brief Color kernels for single instruction set
+struct ColorKernels
+{
+    UpsampleRowFunction upsample_row;
+    FilterRowsFunction filter_rows;
+    ConvertRowFunction convert_row;
+};
+
+/// @brief Provides color kernels for given instruction set.
+///
+/// All the kernels are bit-exact with the scalar (NanoJPEG) ones: SSE2 kernels evaluate the same fixed-point sums on
+/// 16-bit samples with 32-bit accumulators (pmaddwd), 8 resp. 16 samples at once.
+///
+/// @param [in] instruction_set - Instruction set to be used (defaults to best supported)
+ColorKernels GetColorKernels(const InstructionSet instruction_set = GetSupportedInstructionSet());
+
+}  // namespace perception
+
+#endif  // PERCEPTION_IMAGE_HELPER_JPEG_COLOR_H_
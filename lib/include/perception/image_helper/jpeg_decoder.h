@@ -31,9 +31,16 @@
 //    altered in the code, the original author(s) must receive a copy of the
 //    modified code.
 
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "perception/image_helper/jpeg_color.h"
+#include "perception/image_helper/jpeg_idct.h"
+#include "perception/utils/arena.h"
+#include "perception/utils/thread_pool.h"
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4127)  // conditional expression is constant
@@ -56,9 +63,65 @@ class Decoder
         Internal_Finished,  // used internally, will never be reported
     };
 
-    // decode the raw data. object is very large, and probably shouldn't
-    // go on the stack.
-    Decoder(const char *data, size_t size, void *(*allocFunc)(size_t) = malloc, void (*freeFunc)(void *) = free);
+    // decoder for Decode() calls (see below), which is meant to be reused
+    // for a stream of images. object is very large, and probably shouldn't
+    // go on the stack. IDCT and color kernels are picked for given
+    // instruction set (all of them are bit-exact, see jpeg_idct.h and
+    // jpeg_color.h).
+    // with arena set, all buffers (planes, image and scratch) come from it
+    // instead of allocFunc/freeFunc. its owner has to Reset() it between
+    // images, i.e. before each Decode() (the previous image is gone then).
+    Decoder(void *(*allocFunc)(size_t) = malloc, void (*freeFunc)(void *) = free,
+            perception::InstructionSet instructionSet = perception::GetSupportedInstructionSet(),
+            perception::Arena *arena = NULL);
+
+    // decode options, all of them off by default (full size, serial,
+    // whole image, color).
+    // with minWidth/minHeight set, image is downscaled by the largest of
+    // 1/2, 1/4 or 1/8 within DCT domain (reduced IDCTs), which still keeps
+    // it at least minWidth x minHeight.
+    // with threadPool set, restart intervals (if any) are entropy decoded
+    // in parallel.
+    // with cropWidth/cropHeight set, only the crop rectangle (in full size
+    // pixels, clipped to the image) is decoded: MCUs outside of it are
+    // entropy decoded only (no IDCT, upsampling or color conversion) and
+    // the ones below it are not decoded at all. minWidth/minHeight then
+    // apply to the crop.
+    // with lumaOnly set, color images are decoded to their Y plane, i.e.
+    // chroma is only entropy decoded (no IDCT, upsampling or color
+    // conversion) and IsColor() is false.
+    struct DecodeOptions
+    {
+        DecodeOptions()
+            : minWidth(0),
+              minHeight(0),
+              threadPool(NULL),
+              cropX(0),
+              cropY(0),
+              cropWidth(0),
+              cropHeight(0),
+              lumaOnly(false)
+        {
+        }
+
+        int minWidth;
+        int minHeight;
+        perception::ThreadPool *threadPool;
+        int cropX;
+        int cropY;
+        int cropWidth;
+        int cropHeight;
+        bool lumaOnly;
+    };
+
+    // decode the raw data, replacing the previous image (if any). large
+    // tables are kept between calls, thus only the first one pays for them.
+    DecodeResult Decode(const char *data, size_t size, const DecodeOptions &options = DecodeOptions());
+
+    // single image decoder, i.e. Decoder() followed by Decode()
+    Decoder(const char *data, size_t size, void *(*allocFunc)(size_t) = malloc, void (*freeFunc)(void *) = free,
+            perception::InstructionSet instructionSet = perception::GetSupportedInstructionSet(),
+            const DecodeOptions &options = DecodeOptions());
     ~Decoder();
 
     // the result of decode
@@ -66,10 +129,18 @@ class Decoder
 
     // all remaining functions below are only valid if GetResult() == OK.
 
+    // size of decoded image, i.e. of the (scaled) crop
     int GetWidth() const;
     int GetHeight() const;
     bool IsColor() const;
 
+    // position of decoded image within the (scaled) image
+    int GetCropX() const;
+    int GetCropY() const;
+
+    // image downscale as log2, 0 (full size) to 3 (1/8)
+    int GetScaleShift() const;
+
     // if IsColor() then 24bit as R,G,B bytes
     // else 8 bit luminance
     unsigned char *GetImage() const;
@@ -93,6 +164,18 @@ class Decoder
         unsigned char bits, code;
     };
 
+    enum
+    {
+        // combined (code length, run/size, value) lookup covers codes with
+        // code length + value bits <= FAST_BITS, others use the 16-bit table
+        FAST_BITS = 9,
+        // upper limit of row bands converted in parallel
+        MAX_BANDS = 64,
+        // pixels around the crop reached by upsampling filter taps (2
+        // chroma samples, rounded up to the next chroma sample)
+        CROP_MARGIN = 8,
+    };
+
     struct Component
     {
         int cid;
@@ -101,10 +184,22 @@ class Decoder
         int stride;
         int qtsel;
         int actabsel, dctabsel;
-        int dcpred;
         unsigned char *pixels;
     };
 
+    // entropy decoding state, one per restart interval in parallel mode
+    struct Scanner
+    {
+        DecodeResult error;
+        const unsigned char *pos;
+        int size;
+        // bit reservoir, next bufbits bits are the low bits of buf
+        uint64_t buf;
+        int bufbits;
+        int dcpred[3];
+        int block[64];
+    };
+
     struct Context
     {
         DecodeResult error;
@@ -114,127 +209,49 @@ class Decoder
         int width, height;
         int mbwidth, mbheight;
         int mbsizex, mbsizey;
+        // decoded block size is 8 >> scaleshift
+        int scaleshift, minwidth, minheight;
+        // output rectangle within the (scaled) image
+        int cropx, cropy, cropwidth, cropheight;
+        // MCUs [mbx0, mbx1) x [mby0, mby1) are reconstructed, the others
+        // left of, right of and above them are only entropy decoded
+        int mbx0, mbx1, mby0, mby1;
+        // decode Y plane of color images only
+        int lumaonly;
         int ncomp;
         Component comp[3];
         int qtused, qtavail;
         unsigned char qtab[4][64];
-        VlcCode vlctab[4][65536];
-        int buf, bufbits;
-        int block[64];
+        // Huffman tables defined by DHT (bit mask)
+        int vlcavail;
         int rstinterval;
         unsigned char *rgb;
+        // large tables last, those are not reset between images (see
+        // Decode()), as DHT rewrites them entirely and scans check vlcavail
+        VlcCode vlctab[4][65536];
+        // value << 16 | (run << 4 | size) << 5 | total length, 0 if not covered
+        int fastvlc[4][1 << FAST_BITS];
     };
 
     Context ctx;
     char ZZ[64];
     void *(*AllocMem)(size_t);
     void (*FreeMem)(void *);
+    perception::InstructionSet InstructionSet;
+    perception::InverseDctFunction InverseDct;
+    perception::ColorKernels Color;
+    perception::ThreadPool *ThreadPool;
+    perception::Arena *Arena;
 
-    inline unsigned char _Clip(const int x) { return (x < 0) ? 0 : ((x > 0xFF) ? 0xFF : (unsigned char)x); }
-
-    enum
+    // buffers come from the arena (released all at once by its owner) if
+    // there is one, from allocFunc/freeFunc otherwise
+    inline void *_Alloc(const size_t size) { return Arena ? Arena->Allocate(size) : AllocMem(size); }
+    inline void _Free(void *p)
     {
-        W1 = 2841,
-        W2 = 2676,
-        W3 = 2408,
-        W5 = 1609,
-        W6 = 1108,
-        W7 = 565,
-    };
-
-    inline void _RowIDCT(int *blk)
-    {
-        int x0, x1, x2, x3, x4, x5, x6, x7, x8;
-        if (!((x1 = blk[4] << 11) | (x2 = blk[6]) | (x3 = blk[2]) | (x4 = blk[1]) | (x5 = blk[7]) | (x6 = blk[5]) |
-              (x7 = blk[3])))
-        {
-            blk[0] = blk[1] = blk[2] = blk[3] = blk[4] = blk[5] = blk[6] = blk[7] = blk[0] << 3;
-            return;
-        }
-        x0 = (blk[0] << 11) + 128;
-        x8 = W7 * (x4 + x5);
-        x4 = x8 + (W1 - W7) * x4;
-        x5 = x8 - (W1 + W7) * x5;
-        x8 = W3 * (x6 + x7);
-        x6 = x8 - (W3 - W5) * x6;
-        x7 = x8 - (W3 + W5) * x7;
-        x8 = x0 + x1;
-        x0 -= x1;
-        x1 = W6 * (x3 + x2);
-        x2 = x1 - (W2 + W6) * x2;
-        x3 = x1 + (W2 - W6) * x3;
-        x1 = x4 + x6;
-        x4 -= x6;
-        x6 = x5 + x7;
-        x5 -= x7;
-        x7 = x8 + x3;
-        x8 -= x3;
-        x3 = x0 + x2;
-        x0 -= x2;
-        x2 = (181 * (x4 + x5) + 128) >> 8;
-        x4 = (181 * (x4 - x5) + 128) >> 8;
-        blk[0] = (x7 + x1) >> 8;
-        blk[1] = (x3 + x2) >> 8;
-        blk[2] = (x0 + x4) >> 8;
-        blk[3] = (x8 + x6) >> 8;
-        blk[4] = (x8 - x6) >> 8;
-        blk[5] = (x0 - x4) >> 8;
-        blk[6] = (x3 - x2) >> 8;
-        blk[7] = (x7 - x1) >> 8;
+        if (!Arena) FreeMem(p);
     }
 
-    inline void _ColIDCT(const int *blk, unsigned char *out, int stride)
-    {
-        int x0, x1, x2, x3, x4, x5, x6, x7, x8;
-        if (!((x1 = blk[8 * 4] << 8) | (x2 = blk[8 * 6]) | (x3 = blk[8 * 2]) | (x4 = blk[8 * 1]) | (x5 = blk[8 * 7]) |
-              (x6 = blk[8 * 5]) | (x7 = blk[8 * 3])))
-        {
-            x1 = _Clip(((blk[0] + 32) >> 6) + 128);
-            for (x0 = 8; x0; --x0)
-            {
-                *out = (unsigned char)x1;
-                out += stride;
-            }
-            return;
-        }
-        x0 = (blk[0] << 8) + 8192;
-        x8 = W7 * (x4 + x5) + 4;
-        x4 = (x8 + (W1 - W7) * x4) >> 3;
-        x5 = (x8 - (W1 + W7) * x5) >> 3;
-        x8 = W3 * (x6 + x7) + 4;
-        x6 = (x8 - (W3 - W5) * x6) >> 3;
-        x7 = (x8 - (W3 + W5) * x7) >> 3;
-        x8 = x0 + x1;
-        x0 -= x1;
-        x1 = W6 * (x3 + x2) + 4;
-        x2 = (x1 - (W2 + W6) * x2) >> 3;
-        x3 = (x1 + (W2 - W6) * x3) >> 3;
-        x1 = x4 + x6;
-        x4 -= x6;
-        x6 = x5 + x7;
-        x5 -= x7;
-        x7 = x8 + x3;
-        x8 -= x3;
-        x3 = x0 + x2;
-        x0 -= x2;
-        x2 = (181 * (x4 + x5) + 128) >> 8;
-        x4 = (181 * (x4 - x5) + 128) >> 8;
-        *out = _Clip(((x7 + x1) >> 14) + 128);
-        out += stride;
-        *out = _Clip(((x3 + x2) >> 14) + 128);
-        out += stride;
-        *out = _Clip(((x0 + x4) >> 14) + 128);
-        out += stride;
-        *out = _Clip(((x8 + x6) >> 14) + 128);
-        out += stride;
-        *out = _Clip(((x8 - x6) >> 14) + 128);
-        out += stride;
-        *out = _Clip(((x0 - x4) >> 14) + 128);
-        out += stride;
-        *out = _Clip(((x3 - x2) >> 14) + 128);
-        out += stride;
-        *out = _Clip(((x7 - x1) >> 14) + 128);
-    }
+    inline unsigned char _Clip(const int x) { return (x < 0) ? 0 : ((x > 0xFF) ? 0xFF : (unsigned char)x); }
 
 #define JPEG_DECODER_THROW(e) \
     do                        \
@@ -243,66 +260,97 @@ class Decoder
         return;               \
     } while (0)
 
-    inline int _ShowBits(int bits)
+#define JPEG_DECODER_SCAN_THROW(s, e) \
+    do                                \
+    {                                 \
+        (s)->error = e;               \
+        return;                       \
+    } while (0)
+
+    inline void _RefillBits(Scanner *s)
     {
+        // bulk refill, if none of the next 8 bytes is 0xFF (i.e. neither stuffing nor marker)
+        if (s->size >= 8)
+        {
+            const unsigned char *p = s->pos;
+            const uint64_t word = ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) |
+                                  ((uint64_t)p[3] << 32) | ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+                                  ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+            const uint64_t inverted = ~word;
+            if (!((inverted - 0x0101010101010101ULL) & ~inverted & 0x8080808080808080ULL))
+            {
+                const int count = (63 - s->bufbits) >> 3;
+                s->buf = (s->buf << (count << 3)) | (word >> (64 - (count << 3)));
+                s->bufbits += count << 3;
+                s->pos += count;
+                s->size -= count;
+                return;
+            }
+        }
+        // byte-wise refill, at most 16 bits (0xFF + marker) are added per byte
         unsigned char newbyte;
-        if (!bits) return 0;
-        while (ctx.bufbits < bits)
+        while (s->bufbits <= 48)
         {
-            if (ctx.size <= 0)
+            if (s->size <= 0)
             {
-                ctx.buf = (ctx.buf << 8) | 0xFF;
-                ctx.bufbits += 8;
+                s->buf = (s->buf << 8) | 0xFF;
+                s->bufbits += 8;
                 continue;
             }
-            newbyte = *ctx.pos++;
-            ctx.size--;
-            ctx.bufbits += 8;
-            ctx.buf = (ctx.buf << 8) | newbyte;
+            newbyte = *s->pos++;
+            s->size--;
+            s->bufbits += 8;
+            s->buf = (s->buf << 8) | newbyte;
             if (newbyte == 0xFF)
             {
-                if (ctx.size)
+                if (s->size)
                 {
-                    unsigned char marker = *ctx.pos++;
-                    ctx.size--;
+                    unsigned char marker = *s->pos++;
+                    s->size--;
                     switch (marker)
                     {
                         case 0:
                             break;
                         case 0xD9:
-                            ctx.size = 0;
+                            s->size = 0;
                             break;
                         default:
                             if ((marker & 0xF8) != 0xD0)
-                                ctx.error = SyntaxError;
+                                s->error = SyntaxError;
                             else
                             {
-                                ctx.buf = (ctx.buf << 8) | marker;
-                                ctx.bufbits += 8;
+                                s->buf = (s->buf << 8) | marker;
+                                s->bufbits += 8;
                             }
                     }
                 }
                 else
-                    ctx.error = SyntaxError;
+                    s->error = SyntaxError;
             }
         }
-        return (ctx.buf >> (ctx.bufbits - bits)) & ((1 << bits) - 1);
     }
 
-    inline void _SkipBits(int bits)
+    inline int _ShowBits(Scanner *s, int bits)
     {
-        if (ctx.bufbits < bits) (void)_ShowBits(bits);
-        ctx.bufbits -= bits;
+        if (!bits) return 0;
+        if (s->bufbits < bits) _RefillBits(s);
+        return (int)(s->buf >> (s->bufbits - bits)) & ((1 << bits) - 1);
     }
 
-    inline int _GetBits(int bits)
+    inline void _SkipBits(Scanner *s, int bits)
     {
-        int res = _ShowBits(bits);
-        _SkipBits(bits);
+        if (s->bufbits < bits) (void)_ShowBits(s, bits);
+        s->bufbits -= bits;
+    }
+
+    inline int _GetBits(Scanner *s, int bits)
+    {
+        int res = _ShowBits(s, bits);
+        _SkipBits(s, bits);
         return res;
     }
 
-    inline void _ByteAlign(void) { ctx.bufbits &= 0xF8; }
+    inline void _ByteAlign(Scanner *s) { s->bufbits &= 0xF8; }
 
     inline void _Skip(int count)
     {
@@ -328,15 +376,41 @@ class Decoder
         _Skip(ctx.length);
     }
 
+    // channels of decoded image, i.e. 1 for grayscale and luma only
+    inline int _Channels(void) const { return ((ctx.ncomp == 3) && !ctx.lumaonly) ? 3 : 1; }
+
+    // upsampling (up to 2x in each direction) can be fused with color
+    // conversion, i.e. 4:4:4, 4:2:2, 4:4:0 and 4:2:0
+    inline int _IsFused(void) const
+    {
+        int i, fused = (_Channels() == 3);
+        const Component *c;
+        for (i = 0, c = ctx.comp; i < ctx.ncomp; ++i, ++c)
+            fused &= ((c->width << 1) >= ctx.width) && ((c->height << 1) >= ctx.height);
+        return fused;
+    }
+
     inline void _DecodeSOF(void)
     {
-        int i, ssxmax = 0, ssymax = 0;
+        int i, x0, y0, x1, y1, margin, ssxmax = 0, ssymax = 0;
         Component *c;
         _DecodeLength();
         if (ctx.length < 9) JPEG_DECODER_THROW(SyntaxError);
         if (ctx.pos[0] != 8) JPEG_DECODER_THROW(Unsupported);
         ctx.height = _Decode16(ctx.pos + 1);
         ctx.width = _Decode16(ctx.pos + 3);
+        // requested crop (whole image by default), clipped to the image
+        if ((ctx.cropwidth <= 0) || (ctx.cropheight <= 0))
+        {
+            ctx.cropx = ctx.cropy = 0;
+            ctx.cropwidth = ctx.width;
+            ctx.cropheight = ctx.height;
+        }
+        x0 = (ctx.cropx > 0) ? ctx.cropx : 0;
+        y0 = (ctx.cropy > 0) ? ctx.cropy : 0;
+        x1 = ((ctx.cropx + ctx.cropwidth) < ctx.width) ? (ctx.cropx + ctx.cropwidth) : ctx.width;
+        y1 = ((ctx.cropy + ctx.cropheight) < ctx.height) ? (ctx.cropy + ctx.cropheight) : ctx.height;
+        if ((x1 <= x0) || (y1 <= y0)) JPEG_DECODER_THROW(Unsupported);
         ctx.ncomp = ctx.pos[5];
         _Skip(6);
         switch (ctx.ncomp)
@@ -365,6 +439,21 @@ class Decoder
         ctx.mbsizey = ssymax << 3;
         ctx.mbwidth = (ctx.width + ctx.mbsizex - 1) / ctx.mbsizex;
         ctx.mbheight = (ctx.height + ctx.mbsizey - 1) / ctx.mbsizey;
+        // largest downscale keeping the requested size of the crop, from
+        // here on everything (incl. macroblock size) is in the scaled domain
+        while ((ctx.scaleshift < 3) && (ctx.minwidth > 0) && (ctx.minheight > 0) &&
+               (((x1 - x0 + (2 << ctx.scaleshift) - 1) >> (ctx.scaleshift + 1)) >= ctx.minwidth) &&
+               (((y1 - y0 + (2 << ctx.scaleshift) - 1) >> (ctx.scaleshift + 1)) >= ctx.minheight))
+            ++ctx.scaleshift;
+        ctx.width = (ctx.width + (1 << ctx.scaleshift) - 1) >> ctx.scaleshift;
+        ctx.height = (ctx.height + (1 << ctx.scaleshift) - 1) >> ctx.scaleshift;
+        ctx.cropx = x0 >> ctx.scaleshift;
+        ctx.cropy = y0 >> ctx.scaleshift;
+        ctx.cropwidth = ((x1 + (1 << ctx.scaleshift) - 1) >> ctx.scaleshift) - ctx.cropx;
+        ctx.cropheight = ((y1 + (1 << ctx.scaleshift) - 1) >> ctx.scaleshift) - ctx.cropy;
+        ctx.mbsizex >>= ctx.scaleshift;
+        ctx.mbsizey >>= ctx.scaleshift;
+        InverseDct = perception::GetScaledInverseDct(ctx.scaleshift, InstructionSet);
         for (i = 0, c = ctx.comp; i < ctx.ncomp; ++i, ++c)
         {
             c->width = (ctx.width * c->ssx + ssxmax - 1) / ssxmax;
@@ -373,12 +462,28 @@ class Decoder
             c->stride = ctx.mbwidth * ctx.mbsizex * c->ssx / ssxmax;
             if (((c->width < 3) && (c->ssx != ssxmax)) || ((c->height < 3) && (c->ssy != ssymax)))
                 JPEG_DECODER_THROW(Unsupported);
-            if (!(c->pixels = (unsigned char *)AllocMem(c->stride * (ctx.mbheight * ctx.mbsizey * c->ssy / ssymax))))
+            // chroma planes of luma only decode stay NULL, i.e. entropy decoding only
+            if (i && (_Channels() == 1)) continue;
+            if (!(c->pixels = (unsigned char *)_Alloc(c->stride * (ctx.mbheight * ctx.mbsizey * c->ssy / ssymax))))
                 JPEG_DECODER_THROW(OutOfMemory);
         }
-        if (ctx.ncomp == 3)
+        // MCUs covering the crop, incl. the ones reached by upsampling filter
+        // taps. upsampling of whole component planes needs all of them
+        ctx.mbx1 = ctx.mbwidth;
+        ctx.mby1 = ctx.mbheight;
+        if (_IsFused() || ((_Channels() == 1) && (ctx.comp[0].ssx == ssxmax) && (ctx.comp[0].ssy == ssymax)))
+        {
+            margin = _IsFused() ? CROP_MARGIN : 0;
+            ctx.mbx0 = ((ctx.cropx > margin) ? (ctx.cropx - margin) : 0) / ctx.mbsizex;
+            ctx.mby0 = ((ctx.cropy > margin) ? (ctx.cropy - margin) : 0) / ctx.mbsizey;
+            x1 = (ctx.cropx + ctx.cropwidth + margin + ctx.mbsizex - 1) / ctx.mbsizex;
+            y1 = (ctx.cropy + ctx.cropheight + margin + ctx.mbsizey - 1) / ctx.mbsizey;
+            if (x1 < ctx.mbx1) ctx.mbx1 = x1;
+            if (y1 < ctx.mby1) ctx.mby1 = y1;
+        }
+        if (_Channels() == 3)
         {
-            ctx.rgb = (unsigned char *)AllocMem(ctx.width * ctx.height * ctx.ncomp);
+            ctx.rgb = (unsigned char *)_Alloc(ctx.cropwidth * ctx.cropheight * 3);
             if (!ctx.rgb) JPEG_DECODER_THROW(OutOfMemory);
         }
         _Skip(ctx.length);
@@ -386,7 +491,7 @@ class Decoder
 
     inline void _DecodeDHT(void)
     {
-        int codelen, currcnt, remain, spread, i, j;
+        int codelen, currcnt, remain, spread, i, j, table;
         VlcCode *vlc;
         unsigned char counts[16];
         _DecodeLength();
@@ -398,7 +503,9 @@ class Decoder
             i = (i | (i >> 3)) & 3;  // combined DC/AC + tableid value
             for (codelen = 1; codelen <= 16; ++codelen) counts[codelen - 1] = ctx.pos[codelen];
             _Skip(17);
-            vlc = &ctx.vlctab[i][0];
+            table = i;
+            ctx.vlcavail |= 1 << table;
+            vlc = &ctx.vlctab[table][0];
             remain = spread = 65536;
             for (codelen = 1; codelen <= 16; ++codelen)
             {
@@ -425,10 +532,34 @@ class Decoder
                 vlc->bits = 0;
                 ++vlc;
             }
+            _BuildFastVLC(table);
         }
         if (ctx.length) JPEG_DECODER_THROW(SyntaxError);
     }
 
+    inline void _BuildFastVLC(const int table)
+    {
+        const VlcCode *vlc = &ctx.vlctab[table][0];
+        int *fast = &ctx.fastvlc[table][0];
+        int peek, bits, size, value;
+        for (peek = 0; peek < (1 << FAST_BITS); ++peek)
+        {
+            fast[peek] = 0;
+            const VlcCode entry = vlc[peek << (16 - FAST_BITS)];
+            bits = entry.bits;
+            size = entry.code & 15;
+            if (!bits || ((bits + size) > FAST_BITS)) continue;
+            value = 0;
+            if (size)
+            {
+                // same sign extension as _GetVLC
+                value = (peek >> (FAST_BITS - bits - size)) & ((1 << size) - 1);
+                if (value < (1 << (size - 1))) value += ((-1) << size) + 1;
+            }
+            fast[peek] = (int)((unsigned int)value << 16) | (entry.code << 5) | (bits + size);
+        }
+    }
+
     inline void _DecodeDQT(void)
     {
         int i;
@@ -454,49 +585,148 @@ class Decoder
         _Skip(ctx.length);
     }
 
-    inline int _GetVLC(VlcCode *vlc, unsigned char *code)
+    inline int _GetVLC(Scanner *s, VlcCode *vlc, const int *fast, unsigned char *code)
     {
-        int value = _ShowBits(16);
+        if (s->bufbits < 16) _RefillBits(s);
+        const int entry = fast[(int)(s->buf >> (s->bufbits - FAST_BITS)) & ((1 << FAST_BITS) - 1)];
+        if (entry)
+        {
+            // code length, run/size and value in one step
+            s->bufbits -= entry & 31;
+            if (code) *code = (unsigned char)(entry >> 5);
+            return entry >> 16;
+        }
+        int value = (int)(s->buf >> (s->bufbits - 16)) & 0xFFFF;
         int bits = vlc[value].bits;
         if (!bits)
         {
-            ctx.error = SyntaxError;
+            s->error = SyntaxError;
             return 0;
         }
-        _SkipBits(bits);
+        _SkipBits(s, bits);
         value = vlc[value].code;
         if (code) *code = (unsigned char)value;
         bits = value & 15;
         if (!bits) return 0;
-        value = _GetBits(bits);
+        value = _GetBits(s, bits);
         if (value < (1 << (bits - 1))) value += ((-1) << bits) + 1;
         return value;
     }
 
-    inline void _DecodeBlock(Component *c, unsigned char *out)
+    inline void _DecodeBlock(Scanner *s, const int i, unsigned char *out)
     {
+        const Component *c = &ctx.comp[i];
         unsigned char code = 0;
         int value, coef = 0;
-        memset(ctx.block, 0, sizeof(ctx.block));
-        c->dcpred += _GetVLC(&ctx.vlctab[c->dctabsel][0], NULL);
-        ctx.block[0] = (c->dcpred) * ctx.qtab[c->qtsel][0];
+        const int blocksize = 8 >> ctx.scaleshift;
+        memset(s->block, 0, sizeof(s->block));
+        s->dcpred[i] += _GetVLC(s, &ctx.vlctab[c->dctabsel][0], &ctx.fastvlc[c->dctabsel][0], NULL);
+        s->block[0] = (s->dcpred[i]) * ctx.qtab[c->qtsel][0];
         do
         {
-            value = _GetVLC(&ctx.vlctab[c->actabsel][0], &code);
+            value = _GetVLC(s, &ctx.vlctab[c->actabsel][0], &ctx.fastvlc[c->actabsel][0], &code);
             if (!code) break;  // EOB
-            if (!(code & 0x0F) && (code != 0xF0)) JPEG_DECODER_THROW(SyntaxError);
+            if (!(code & 0x0F) && (code != 0xF0)) JPEG_DECODER_SCAN_THROW(s, SyntaxError);
             coef += (code >> 4) + 1;
-            if (coef > 63) JPEG_DECODER_THROW(SyntaxError);
-            ctx.block[(int)ZZ[coef]] = value * ctx.qtab[c->qtsel][coef];
+            if (coef > 63) JPEG_DECODER_SCAN_THROW(s, SyntaxError);
+            s->block[(int)ZZ[coef]] = value * ctx.qtab[c->qtsel][coef];
         } while (coef < 63);
-        for (coef = 0; coef < 64; coef += 8) _RowIDCT(&ctx.block[coef]);
-        for (coef = 0; coef < 8; ++coef) _ColIDCT(&ctx.block[coef], &out[coef], c->stride);
+        if (!out) return;  // outside of the crop (or chroma of luma only decode)
+        if (!coef)
+        {
+            // DC only, i.e. what both IDCT passes reduce to without AC coefficients
+            const unsigned char dc = _Clip((((s->block[0] << 3) + 32) >> 6) + 128);
+            for (coef = 0; coef < blocksize; ++coef) memset(&out[coef * c->stride], dc, blocksize);
+            return;
+        }
+        InverseDct(s->block, out, c->stride);
+    }
+
+    // decodes count MCUs from first (in raster order), without restart markers
+    inline void _DecodeMCUs(Scanner *s, const int first, const int count)
+    {
+        int i, m, mbx, mby, sbx, sby, inside;
+        const Component *c;
+        for (m = first; m < (first + count); ++m)
+        {
+            mby = m / ctx.mbwidth;
+            mbx = m % ctx.mbwidth;
+            inside = (mbx >= ctx.mbx0) && (mbx < ctx.mbx1) && (mby >= ctx.mby0);
+            for (i = 0, c = ctx.comp; i < ctx.ncomp; ++i, ++c)
+                for (sby = 0; sby < c->ssy; ++sby)
+                    for (sbx = 0; sbx < c->ssx; ++sbx)
+                    {
+                        // chroma of luma only decode has no plane, i.e. entropy decoding only
+                        _DecodeBlock(s, i,
+                                     (inside && c->pixels) ? &c->pixels[((mby * c->ssy + sby) * c->stride +
+                                                                         mbx * c->ssx + sbx) *
+                                                                        (8 >> ctx.scaleshift)]
+                                                           : NULL);
+                        if (s->error) return;
+                    }
+        }
+    }
+
+    // decodes restart intervals in parallel, each of them starts right
+    // after a RST marker with reset predictors. returns 0 if markers could
+    // not be located (left to the serial decode)
+    inline int _DecodeSegments(const int total)
+    {
+        const int count = (total + ctx.rstinterval - 1) / ctx.rstinterval;
+        const unsigned char **starts;
+        DecodeResult *errors;
+        int i, found = 0;
+        if (!(starts = (const unsigned char **)_Alloc((count + 1) * sizeof(*starts)))) return 0;
+        if (!(errors = (DecodeResult *)_Alloc(count * sizeof(*errors))))
+        {
+            _Free((void *)starts);
+            return 0;
+        }
+        // entropy coded data never contains 0xFF followed by RST (stuffed
+        // 0xFF is followed by 0x00), the last interval ends at EOI
+        starts[0] = ctx.pos;
+        for (i = 0; ((i + 1) < ctx.size) && (found < (count - 1)); ++i)
+        {
+            if ((ctx.pos[i] != 0xFF) || ((ctx.pos[i + 1] & 0xF8) != 0xD0)) continue;
+            if ((ctx.pos[i + 1] & 7) != (found & 7)) break;
+            starts[++found] = &ctx.pos[i + 2];
+            ++i;
+        }
+        starts[count] = &ctx.pos[ctx.size];
+        if (found == (count - 1))
+        {
+            ThreadPool->ParallelFor((size_t)count, [&](const size_t segment) {
+                const int first = (int)segment * ctx.rstinterval;
+                const int last = (first + ctx.rstinterval < total) ? (first + ctx.rstinterval) : total;
+                Scanner s;
+                memset(&s, 0, sizeof(Scanner));
+                s.pos = starts[segment];
+                s.size = (int)(starts[segment + 1] - starts[segment]);
+                _DecodeMCUs(&s, first, last - first);
+                // same check as the serial decode, i.e. interval ends right at its marker
+                if (!s.error && (last < total))
+                {
+                    _ByteAlign(&s);
+                    if (_GetBits(&s, 16) != (0xFFD0 | ((int)segment & 7))) s.error = SyntaxError;
+                }
+                errors[segment] = s.error;
+            });
+            for (i = 0; i < count; ++i)
+                if (errors[i]) break;
+            ctx.error = (i < count) ? errors[i] : Internal_Finished;
+        }
+        _Free((void *)errors);
+        _Free((void *)starts);
+        return found == (count - 1);
     }
 
     inline void _DecodeScan(void)
     {
-        int i, mbx, mby, sbx, sby;
-        int rstcount = ctx.rstinterval, nextrst = 0;
+        int i, m, count, nextrst = 0;
+        // MCU rows below the crop are left out
+        const int total = ctx.mbwidth * ctx.mby1;
+        const int interval = ctx.rstinterval ? ctx.rstinterval : total;
+        Scanner s;
         Component *c;
         _DecodeLength();
         if (ctx.length < (4 + 2 * ctx.ncomp)) JPEG_DECODER_THROW(SyntaxError);
@@ -508,126 +738,165 @@ class Decoder
             if (ctx.pos[1] & 0xEE) JPEG_DECODER_THROW(SyntaxError);
             c->dctabsel = ctx.pos[1] >> 4;
             c->actabsel = (ctx.pos[1] & 1) | 2;
+            // (not yet) defined tables decode nothing
+            if (!(ctx.vlcavail & (1 << c->dctabsel)) || !(ctx.vlcavail & (1 << c->actabsel)))
+                JPEG_DECODER_THROW(SyntaxError);
             _Skip(2);
         }
         if (ctx.pos[0] || (ctx.pos[1] != 63) || ctx.pos[2]) JPEG_DECODER_THROW(Unsupported);
         _Skip(ctx.length);
-        for (mby = 0; mby < ctx.mbheight; ++mby)
-            for (mbx = 0; mbx < ctx.mbwidth; ++mbx)
+        if (ThreadPool && (ThreadPool->GetSize() > 1) && (interval < total) && _DecodeSegments(total)) return;
+
+        memset(&s, 0, sizeof(Scanner));
+        s.pos = ctx.pos;
+        s.size = ctx.size;
+        for (m = 0; m < total; m += interval)
+        {
+            count = ((total - m) < interval) ? (total - m) : interval;
+            _DecodeMCUs(&s, m, count);
+            if (s.error) JPEG_DECODER_THROW(s.error);
+            // no marker after the last interval
+            if ((m + count) < total)
             {
-                for (i = 0, c = ctx.comp; i < ctx.ncomp; ++i, ++c)
-                    for (sby = 0; sby < c->ssy; ++sby)
-                        for (sbx = 0; sbx < c->ssx; ++sbx)
-                        {
-                            _DecodeBlock(c, &c->pixels[((mby * c->ssy + sby) * c->stride + mbx * c->ssx + sbx) << 3]);
-                            if (ctx.error) return;
-                        }
-                if (ctx.rstinterval && !(--rstcount))
-                {
-                    _ByteAlign();
-                    i = _GetBits(16);
-                    if (((i & 0xFFF8) != 0xFFD0) || ((i & 7) != nextrst)) JPEG_DECODER_THROW(SyntaxError);
-                    nextrst = (nextrst + 1) & 7;
-                    rstcount = ctx.rstinterval;
-                    for (i = 0; i < 3; ++i) ctx.comp[i].dcpred = 0;
-                }
+                _ByteAlign(&s);
+                i = _GetBits(&s, 16);
+                if (((i & 0xFFF8) != 0xFFD0) || ((i & 7) != nextrst)) JPEG_DECODER_THROW(SyntaxError);
+                nextrst = (nextrst + 1) & 7;
+                for (i = 0; i < 3; ++i) s.dcpred[i] = 0;
             }
+        }
         ctx.error = Internal_Finished;
     }
 
-    enum
-    {
-        CF4A = (-9),
-        CF4B = (111),
-        CF4C = (29),
-        CF4D = (-3),
-        CF3A = (28),
-        CF3B = (109),
-        CF3C = (-9),
-        CF3X = (104),
-        CF3Y = (27),
-        CF3Z = (-3),
-        CF2A = (139),
-        CF2B = (-11),
-    };
-
-    inline unsigned char CF(const int x) { return _Clip((x + 64) >> 7); }
-
     inline void _UpsampleH(Component *c)
     {
-        const int xmax = c->width - 3;
         unsigned char *out, *lin, *lout;
-        int x, y;
-        out = (unsigned char *)AllocMem((c->width * c->height) << 1);
+        int y;
+        out = (unsigned char *)_Alloc((c->width * c->height) << 1);
         if (!out) JPEG_DECODER_THROW(OutOfMemory);
         lin = c->pixels;
         lout = out;
         for (y = c->height; y; --y)
         {
-            lout[0] = CF(CF2A * lin[0] + CF2B * lin[1]);
-            lout[1] = CF(CF3X * lin[0] + CF3Y * lin[1] + CF3Z * lin[2]);
-            lout[2] = CF(CF3A * lin[0] + CF3B * lin[1] + CF3C * lin[2]);
-            for (x = 0; x < xmax; ++x)
-            {
-                lout[(x << 1) + 3] = CF(CF4A * lin[x] + CF4B * lin[x + 1] + CF4C * lin[x + 2] + CF4D * lin[x + 3]);
-                lout[(x << 1) + 4] = CF(CF4D * lin[x] + CF4C * lin[x + 1] + CF4B * lin[x + 2] + CF4A * lin[x + 3]);
-            }
+            Color.upsample_row(lin, c->width, lout);
             lin += c->stride;
             lout += c->width << 1;
-            lout[-3] = CF(CF3A * lin[-1] + CF3B * lin[-2] + CF3C * lin[-3]);
-            lout[-2] = CF(CF3X * lin[-1] + CF3Y * lin[-2] + CF3Z * lin[-3]);
-            lout[-1] = CF(CF2A * lin[-1] + CF2B * lin[-2]);
         }
         c->width <<= 1;
         c->stride = c->width;
-        FreeMem(c->pixels);
+        _Free(c->pixels);
         c->pixels = out;
     }
 
     inline void _UpsampleV(Component *c)
     {
-        const int w = c->width, s1 = c->stride, s2 = s1 + s1;
-        unsigned char *out, *cin, *cout;
-        int x, y;
-        out = (unsigned char *)AllocMem((c->width * c->height) << 1);
+        const unsigned char *rows[4];
+        unsigned char *out;
+        int i, y;
+        out = (unsigned char *)_Alloc((c->width * c->height) << 1);
         if (!out) JPEG_DECODER_THROW(OutOfMemory);
-        for (x = 0; x < w; ++x)
-        {
-            cin = &c->pixels[x];
-            cout = &out[x];
-            *cout = CF(CF2A * cin[0] + CF2B * cin[s1]);
-            cout += w;
-            *cout = CF(CF3X * cin[0] + CF3Y * cin[s1] + CF3Z * cin[s2]);
-            cout += w;
-            *cout = CF(CF3A * cin[0] + CF3B * cin[s1] + CF3C * cin[s2]);
-            cout += w;
-            cin += s1;
-            for (y = c->height - 3; y; --y)
-            {
-                *cout = CF(CF4A * cin[-s1] + CF4B * cin[0] + CF4C * cin[s1] + CF4D * cin[s2]);
-                cout += w;
-                *cout = CF(CF4D * cin[-s1] + CF4C * cin[0] + CF4B * cin[s1] + CF4A * cin[s2]);
-                cout += w;
-                cin += s1;
-            }
-            cin += s1;
-            *cout = CF(CF3A * cin[0] + CF3B * cin[-s1] + CF3C * cin[-s2]);
-            cout += w;
-            *cout = CF(CF3X * cin[0] + CF3Y * cin[-s1] + CF3Z * cin[-s2]);
-            cout += w;
-            *cout = CF(CF2A * cin[0] + CF2B * cin[-s1]);
+        for (y = 0; y < (c->height << 1); ++y)
+        {
+            const perception::UpsampleTaps taps = perception::GetUpsampleTaps(y, c->height);
+            for (i = 0; i < 4; ++i) rows[i] = &c->pixels[taps.index[i] * c->stride];
+            Color.filter_rows(rows, taps.weight, c->width, &out[y * c->width]);
         }
         c->height <<= 1;
         c->stride = c->width;
-        FreeMem(c->pixels);
+        _Free(c->pixels);
         c->pixels = out;
     }
 
+    // input row of horizontally upsampled (if needed) component, cached
+    // within 4 slots, as vertical filter taps span 4 consecutive rows.
+    // points to the first column of the crop
+    inline const unsigned char *_UpsampledRow(Component *c, unsigned char **slots, int *tags, const int row)
+    {
+        const unsigned char *lin = &c->pixels[row * c->stride];
+        int lo, hi;
+        if (c->width >= ctx.width) return &lin[ctx.cropx];
+        // columns of the crop plus the taps of its outermost pixels, the
+        // edge taps used for the first and last 3 outputs of this window
+        // fall outside of the crop (unless it is the edge of the image)
+        lo = ((ctx.cropx >> 1) > 2) ? ((ctx.cropx >> 1) - 2) : 0;
+        hi = ((ctx.cropx + ctx.cropwidth + 1) >> 1) + 2;
+        if (hi > c->width) hi = c->width;
+        if (tags[row & 3] != row)
+        {
+            Color.upsample_row(&lin[lo], hi - lo, slots[row & 3]);
+            tags[row & 3] = row;
+        }
+        return &slots[row & 3][ctx.cropx - (lo << 1)];
+    }
+
+    // fused upsampling (up to 2x in each direction) and color conversion,
+    // row by row into ctx.rgb, i.e. without full size component planes.
+    // converts rows [first, last) of the crop, independent of other rows
+    inline DecodeResult _ConvertRows(const int first, const int last)
+    {
+        const unsigned char *rows[4], *lines[3];
+        unsigned char *slots[3][4], *filtered[3], *scratch, *p;
+        int tags[3][4];
+        int i, j, y;
+        size_t size = 0;
+        Component *c;
+        for (i = 0, c = ctx.comp; i < 3; ++i, ++c) size += 4 * (c->width << 1) + ctx.width;
+        if (!(scratch = (unsigned char *)_Alloc(size))) return OutOfMemory;
+        for (i = 0, c = ctx.comp, p = scratch; i < 3; ++i, ++c)
+        {
+            for (j = 0; j < 4; ++j, p += c->width << 1)
+            {
+                slots[i][j] = p;
+                tags[i][j] = -1;
+            }
+            filtered[i] = p;
+            p += ctx.width;
+        }
+        for (y = first; y < last; ++y)
+        {
+            for (i = 0, c = ctx.comp; i < 3; ++i, ++c)
+            {
+                if (c->height >= ctx.height)
+                {
+                    lines[i] = _UpsampledRow(c, slots[i], tags[i], y);
+                    continue;
+                }
+                const perception::UpsampleTaps taps = perception::GetUpsampleTaps(y, c->height);
+                for (j = 0; j < 4; ++j) rows[j] = _UpsampledRow(c, slots[i], tags[i], taps.index[j]);
+                Color.filter_rows(rows, taps.weight, ctx.cropwidth, filtered[i]);
+                lines[i] = filtered[i];
+            }
+            Color.convert_row(lines[0], lines[1], lines[2], ctx.cropwidth,
+                              &ctx.rgb[(y - ctx.cropy) * ctx.cropwidth * 3]);
+        }
+        _Free(scratch);
+        return OK;
+    }
+
     inline void _Convert()
     {
         int i;
+        const int fused = _IsFused();
         Component *c;
-        for (i = 0, c = ctx.comp; i < ctx.ncomp; ++i, ++c)
+        if (fused && ThreadPool && (ThreadPool->GetSize() > 1))
+        {
+            // bands of rows in parallel, one per thread
+            DecodeResult errors[MAX_BANDS] = {OK};
+            const int bands = (ThreadPool->GetSize() < MAX_BANDS) ? (int)ThreadPool->GetSize() : MAX_BANDS;
+            ThreadPool->ParallelFor((size_t)bands, [&](const size_t band) {
+                errors[band] = _ConvertRows(ctx.cropy + (int)band * ctx.cropheight / bands,
+                                            ctx.cropy + ((int)band + 1) * ctx.cropheight / bands);
+            });
+            for (i = 0; i < bands; ++i)
+                if (errors[i]) JPEG_DECODER_THROW(errors[i]);
+            return;
+        }
+        if (fused)
+        {
+            ctx.error = _ConvertRows(ctx.cropy, ctx.cropy + ctx.cropheight);
+            return;
+        }
+        for (i = 0, c = ctx.comp; i < _Channels(); ++i, ++c)
         {
             while ((c->width < ctx.width) || (c->height < ctx.height))
             {
@@ -638,42 +907,38 @@ class Decoder
             }
             if ((c->width < ctx.width) || (c->height < ctx.height)) JPEG_DECODER_THROW(InternalError);
         }
-        if (ctx.ncomp == 3)
+        if (_Channels() == 3)
         {
             // convert to RGB
-            int x, yy;
+            int yy;
             unsigned char *prgb = ctx.rgb;
-            const unsigned char *py = ctx.comp[0].pixels;
-            const unsigned char *pcb = ctx.comp[1].pixels;
-            const unsigned char *pcr = ctx.comp[2].pixels;
-            for (yy = ctx.height; yy; --yy)
+            const unsigned char *py = &ctx.comp[0].pixels[ctx.cropy * ctx.comp[0].stride + ctx.cropx];
+            const unsigned char *pcb = &ctx.comp[1].pixels[ctx.cropy * ctx.comp[1].stride + ctx.cropx];
+            const unsigned char *pcr = &ctx.comp[2].pixels[ctx.cropy * ctx.comp[2].stride + ctx.cropx];
+            for (yy = ctx.cropheight; yy; --yy)
             {
-                for (x = 0; x < ctx.width; ++x)
-                {
-                    int y = py[x] << 8;
-                    int cb = pcb[x] - 128;
-                    int cr = pcr[x] - 128;
-                    *prgb++ = _Clip((y + 359 * cr + 128) >> 8);
-                    *prgb++ = _Clip((y - 88 * cb - 183 * cr + 128) >> 8);
-                    *prgb++ = _Clip((y + 454 * cb + 128) >> 8);
-                }
+                Color.convert_row(py, pcb, pcr, ctx.cropwidth, prgb);
+                prgb += ctx.cropwidth * 3;
                 py += ctx.comp[0].stride;
                 pcb += ctx.comp[1].stride;
                 pcr += ctx.comp[2].stride;
             }
         }
-        else if (ctx.comp[0].width != ctx.comp[0].stride)
+        else if (ctx.cropx || ctx.cropy || (ctx.cropwidth != ctx.comp[0].stride))
         {
-            // grayscale -> only remove stride
-            unsigned char *pin = &ctx.comp[0].pixels[ctx.comp[0].stride];
-            unsigned char *pout = &ctx.comp[0].pixels[ctx.comp[0].width];
+            // grayscale -> only remove stride (and cut out the crop), rows
+            // move towards the start of the plane
+            unsigned char *pin = &ctx.comp[0].pixels[ctx.cropy * ctx.comp[0].stride + ctx.cropx];
+            unsigned char *pout = ctx.comp[0].pixels;
             int y;
-            for (y = ctx.comp[0].height - 1; y; --y)
+            for (y = ctx.cropheight; y; --y)
             {
-                memcpy(pout, pin, ctx.comp[0].width);
+                memmove(pout, pin, ctx.cropwidth);
                 pin += ctx.comp[0].stride;
-                pout += ctx.comp[0].width;
+                pout += ctx.cropwidth;
             }
+            ctx.comp[0].width = ctx.cropwidth;
+            ctx.comp[0].height = ctx.cropheight;
             ctx.comp[0].stride = ctx.comp[0].width;
         }
     }
@@ -723,8 +988,15 @@ class Decoder
     }
 };
 
-inline Decoder::Decoder(const char *data, size_t size, void *(*allocFunc)(size_t), void (*freeFunc)(void *))
-    : AllocMem(allocFunc), FreeMem(freeFunc)
+inline Decoder::Decoder(void *(*allocFunc)(size_t), void (*freeFunc)(void *), perception::InstructionSet instructionSet,
+                        perception::Arena *arena)
+    : AllocMem(allocFunc),
+      FreeMem(freeFunc),
+      InstructionSet(instructionSet),
+      InverseDct(perception::GetInverseDct(instructionSet)),
+      Color(perception::GetColorKernels(instructionSet)),
+      ThreadPool(NULL),
+      Arena(arena)
 {
     // should be static data, but this keeps us as a header
     char temp[64] = {0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,  12, 19, 26, 33, 40, 48,
@@ -732,22 +1004,53 @@ inline Decoder::Decoder(const char *data, size_t size, void *(*allocFunc)(size_t
                      30, 37, 44, 51, 58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63};
     memcpy(ZZ, temp, sizeof(ZZ));
     memset(&ctx, 0, sizeof(Context));
-    _Decode((const unsigned char *)data, size);
+    // nothing decoded yet
+    ctx.error = NotAJpeg;
+}
+
+inline Decoder::Decoder(const char *data, size_t size, void *(*allocFunc)(size_t), void (*freeFunc)(void *),
+                        perception::InstructionSet instructionSet, const DecodeOptions &options)
+    : Decoder(allocFunc, freeFunc, instructionSet)
+{
+    Decode(data, size, options);
+}
+
+inline Decoder::DecodeResult Decoder::Decode(const char *data, size_t size, const DecodeOptions &options)
+{
+    int i;
+    for (i = 0; i < 3; ++i)
+        if (ctx.comp[i].pixels) _Free((void *)ctx.comp[i].pixels);
+    if (ctx.rgb) _Free((void *)ctx.rgb);
+    memset(&ctx, 0, offsetof(Context, vlctab));
+    ThreadPool = options.threadPool;
+    ctx.minwidth = options.minWidth;
+    ctx.minheight = options.minHeight;
+    ctx.cropx = options.cropX;
+    ctx.cropy = options.cropY;
+    ctx.cropwidth = options.cropWidth;
+    ctx.cropheight = options.cropHeight;
+    ctx.lumaonly = options.lumaOnly;
+    // early returns of _Decode (i.e. NotAJpeg) are not stored within context
+    ctx.error = _Decode((const unsigned char *)data, size);
+    return ctx.error;
 }
 
 inline Decoder::DecodeResult Decoder::GetResult() const { return ctx.error; }
-inline int Decoder::GetWidth() const { return ctx.width; }
-inline int Decoder::GetHeight() const { return ctx.height; }
-inline bool Decoder::IsColor() const { return ctx.ncomp != 1; }
-inline unsigned char *Decoder::GetImage() const { return (ctx.ncomp == 1) ? ctx.comp[0].pixels : ctx.rgb; }
-inline size_t Decoder::GetImageSize(void) const { return ctx.width * ctx.height * ctx.ncomp; }
+inline int Decoder::GetWidth() const { return ctx.cropwidth; }
+inline int Decoder::GetHeight() const { return ctx.cropheight; }
+inline bool Decoder::IsColor() const { return _Channels() != 1; }
+inline int Decoder::GetCropX() const { return ctx.cropx; }
+inline int Decoder::GetCropY() const { return ctx.cropy; }
+inline int Decoder::GetScaleShift() const { return ctx.scaleshift; }
+inline unsigned char *Decoder::GetImage() const { return (_Channels() == 1) ? ctx.comp[0].pixels : ctx.rgb; }
+inline size_t Decoder::GetImageSize(void) const { return ctx.cropwidth * ctx.cropheight * _Channels(); }
 
 inline Decoder::~Decoder()
 {
     int i;
     for (i = 0; i < 3; ++i)
-        if (ctx.comp[i].pixels) FreeMem((void *)ctx.comp[i].pixels);
-    if (ctx.rgb) FreeMem((void *)ctx.rgb);
+        if (ctx.comp[i].pixels) _Free((void *)ctx.comp[i].pixels);
+    if (ctx.rgb) _Free((void *)ctx.rgb);
 }
 
 }  // namespace Jpeg
@@ -756,5 +1059,6 @@ inline Decoder::~Decoder()
 #endif
 
 #undef JPEG_DECODER_THROW
+#undef JPEG_DECODER_SCAN_THROW
 
 #endif
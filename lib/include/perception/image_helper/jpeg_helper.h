@@ -13,6 +13,8 @@
 
 #include "perception/image_helper/i_image_helper.h"
 #include "perception/image_helper/jpeg_decoder.h"
+#include "perception/utils/arena.h"
+#include "perception/utils/thread_pool.h"
 
 namespace perception
 {
@@ -34,12 +36,62 @@ class JpegImageHelper : public IImageHelper
     virtual std::vector<std::uint8_t> ReadImage(const std::string& image_path, std::int32_t* width,
                                                 std::int32_t* height, std::int32_t* channels) override;
 
+    /// @brief Read JPG properties from frame header (SOF). Only the markers up to it are read, skipping payload of
+    ///        others (i.e. EXIF thumbnails).
+    /// @param [in] image_path - Path to JPG Image
+    /// @return info - Image Format, Size, Channels and Subsampling
+    virtual ImageInfo Probe(const std::string& image_path) const override;
+
+    /// @brief Read JPG Image file without copies, i.e. file is mmap-ed and decoded image is borrowed from decoder.
+    ///        Decoder and its buffers (arena) are reused, thus images of the same size do not allocate.
+    /// @param [in] image_path - Path to JPG Image
+    /// @param [out] width - Image Width
+    /// @param [out] height - Image Height
+    /// @param [out] channels - Image Channels
+    /// @return data - Image Data, valid until the next read or destruction
+    virtual const std::uint8_t* ReadImageView(const std::string& image_path, std::int32_t* width,
+                                              std::int32_t* height, std::int32_t* channels) override;
+
+    /// @brief Set minimum size of decoded images. Images are downscaled by 1/2, 1/4 or 1/8 within DCT domain
+    ///        (i.e. before IDCT), using the largest scale which still keeps them at least width x height.
+    /// @param [in] width - Minimum Image Width (0 for full size)
+    /// @param [in] height - Minimum Image Height (0 for full size)
+    virtual void SetMinimumSize(const std::int32_t width, const std::int32_t height) override;
+
+    /// @brief Set number of threads used to decode single image. Restart intervals (if the image has restart
+    ///        markers) and color conversion are spread over them.
+    /// @param [in] number_of_threads - Number of Threads (1 for serial decode)
+    virtual void SetNumberOfThreads(const std::int32_t number_of_threads) override;
+
+    /// @brief Set region of interest. MCUs outside of it are only entropy decoded (no IDCT, upsampling or color
+    ///        conversion), the ones below it are skipped. Minimum size (see SetMinimumSize) then applies to it.
+    /// @param [in] x - Left of Region (full size pixels)
+    /// @param [in] y - Top of Region (full size pixels)
+    /// @param [in] width - Region Width (0 for whole image)
+    /// @param [in] height - Region Height (0 for whole image)
+    virtual void SetRegionOfInterest(const std::int32_t x, const std::int32_t y, const std::int32_t width,
+                                     const std::int32_t height) override;
+
+    /// @brief Set luma only read. Color images are decoded to their Y plane (single channel), i.e. chroma is only
+    ///        entropy decoded (no IDCT, upsampling or color conversion).
+    /// @param [in] luma_only - Read luma only (false for color)
+    virtual void SetLumaOnly(const bool luma_only) override;
+
   private:
     /// @brief Decode Image Data from provided image buffer
     virtual std::vector<std::uint8_t> DecodeImage(const std::uint8_t* input) const override;
 
-    /// @brief JPG Decoder
+    /// @brief Buffers of JPG Decoder (component planes, image and scratch), reset for each image
+    Arena arena_;
+
+    /// @brief JPG Decoder, reused for all images
     std::unique_ptr<Jpeg::Decoder> jpeg_decoder_;
+
+    /// @brief Decode Threads, nullptr for serial decode
+    std::unique_ptr<ThreadPool> thread_pool_;
+
+    /// @brief Decode Options (minimum size, decode threads, region of interest and luma only), see setters
+    Jpeg::Decoder::DecodeOptions decode_options_;
 };
 }  // namespace perception
 #endif  /// PERCEPTION_IMAGE_HELPER_JPEG_HELPER_H_
\ No newline at end of file
@@ -0,0 +1,38 @@
+///
+/// @file jpeg_idct.h
+/// @brief Contains Inverse DCT kernels used by JPG Decoder
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_IMAGE_HELPER_JPEG_IDCT_H_
+#define PERCEPTION_IMAGE_HELPER_JPEG_IDCT_H_
+
+#include <cstdint>
+
+#include "perception/utils/cpu_features.h"
+
+namespace perception
+{
+/// @brief Signature of Inverse DCT kernels
+/// @param [in,out] block - Dequantized 8x8 coefficients (row-major, natural order), clobbered
+/// @param [out] output - 8x8 pixels (level shifted by +128 and clipped to [0, 255])
+/// @param [in] stride - Output row stride (bytes)
+using InverseDctFunction = void (*)(std::int32_t* block, std::uint8_t* output, const std::int32_t stride);
+
+/// @brief Provides 8x8 Inverse DCT kernel for given instruction set.
+///
+/// All the kernels are bit-exact with the scalar (NanoJPEG) integer IDCT: SSE2/AVX2 kernels evaluate the same
+/// fixed-point butterflies on 32-bit lanes (4 resp. 8 rows/columns at once), including wrap-around and rounding.
+///
+/// @param [in] instruction_set - Instruction set to be used (defaults to best supported)
+InverseDctFunction GetInverseDct(const InstructionSet instruction_set = GetSupportedInstructionSet());
+
+/// @brief Provides Inverse DCT kernel, which downscales block by 2^scale_shift within DCT domain, i.e. outputs
+///        (8 >> scale_shift) x (8 >> scale_shift) pixels from the lowest coefficients only (4x4, 2x2 or DC).
+/// @param [in] scale_shift - 0 (full 8x8, see GetInverseDct()), 1 (4x4), 2 (2x2) or 3 (1x1)
+/// @param [in] instruction_set - Instruction set to be used for full 8x8 kernel (defaults to best supported)
+InverseDctFunction GetScaledInverseDct(const std::int32_t scale_shift,
+                                       const InstructionSet instruction_set = GetSupportedInstructionSet());
+
+}  // namespace perception
+
+#endif  // PERCEPTION_IMAGE_HELPER_JPEG_IDCT_H_
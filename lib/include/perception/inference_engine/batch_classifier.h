@@ -0,0 +1,146 @@
+///
+/// @file batch_classifier.h
+/// @brief Contains class definitions for Batch Classifier (many images, one model, parallel workers)
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_INFERENCE_ENGINE_BATCH_CLASSIFIER_H_
+#define PERCEPTION_INFERENCE_ENGINE_BATCH_CLASSIFIER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/interpreter.h"
+
+#include "perception/inference_engine/interpreter_pool.h"
+#include "perception/inference_engine/preprocessing_engine.h"
+#include "perception/utils/latency_statistics.h"
+
+namespace perception
+{
+/// @brief Result of single image
+struct BatchResult
+{
+    /// @brief Image Index (i.e. position in the input list)
+    std::size_t image_index;
+
+    /// @brief Image Path
+    std::string image_path;
+
+    /// @brief vector of pair of (confidence, label idx), empty on failure
+    std::vector<std::pair<float, std::int32_t>> results;
+
+    /// @brief Latency of decode, preprocess, invoke and postprocess (ms), incl. wait for an interpreter
+    double latency_ms;
+
+    /// @brief Failure reason (i.e. unreadable image), empty on success
+    std::string error;
+};
+
+/// @brief Statistics of single Run()
+struct BatchStatistics
+{
+    /// @brief Number of classified resp. failed images
+    std::size_t images;
+    std::size_t failures;
+
+    /// @brief Wall time (ms)
+    double wall_time_ms;
+
+    /// @brief Aggregate throughput, i.e. images / wall time
+    double images_per_second;
+
+    /// @brief Per image latency (classified images only)
+    LatencyStatistics latency;
+};
+
+/// @brief Batch Classifier, which spreads a list of images across worker threads sharing one model.
+///
+/// Each worker claims the next unclassified image, decodes and preprocesses it on its own (helpers and scratch
+/// tensor per worker), then leases an interpreter from the pool only for invoke and top results. Failing images
+/// are reported through their result instead of aborting the run, so one corrupt file does not cost a nightly job.
+///
+/// @note Interpreters come from InterpreterPool, i.e. builtin kernels (no delegate).
+class BatchClassifier
+{
+  public:
+    /// @brief Callback invoked for each image result, in completion order (calls are serialized)
+    using ResultCallback = std::function<void(const BatchResult&)>;
+
+    /// @brief Constructor
+    /// @param [in] pool - Interpreter Pool (all interpreters with allocated tensors of same model)
+    /// @param [in] input_mean - Input Mean
+    /// @param [in] input_std - Input StdDev
+    /// @param [in] number_of_results - Number of Results per image
+    /// @param [in] number_of_workers - Number of Worker Threads
+    BatchClassifier(InterpreterPool* pool, const float input_mean, const float input_std,
+                    const std::int32_t number_of_results, const std::size_t number_of_workers);
+
+    /// @brief Destructor
+    ~BatchClassifier();
+
+    /// @brief Classifies all the images
+    /// @param [in] image_paths - Image Paths (BMP or JPEG)
+    /// @param [in] callback - Callback for each image result (i.e. streaming to file)
+    /// @return Statistics (throughput and per image latency)
+    /// @throws first exception thrown by the callback (remaining images are skipped)
+    BatchStatistics Run(const std::vector<std::string>& image_paths, const ResultCallback& callback);
+
+    /// @brief Lists images to classify, i.e. BMP and JPEG files of a directory (sorted, not recursive) or the lines
+    ///        of a manifest file (one image path per line, empty lines and lines starting with '#' are skipped)
+    /// @param [in] path - Directory or Manifest File Path
+    /// @throws std::runtime_error if path does not exist
+    static std::vector<std::string> ListImages(const std::string& path);
+
+  private:
+    /// @brief State of single worker (image helpers, preprocessing engine and scratch Model Input)
+    struct Worker;
+
+    /// @brief Worker thread loop, classifies images until there are none left
+    void Work(const std::vector<std::string>& image_paths, const ResultCallback& callback);
+
+    /// @brief Classifies single image
+    /// @param [in] image_path - Image Path
+    /// @param [in] worker - State of calling worker
+    /// @return vector of pair of (confidence, label idx)
+    std::vector<std::pair<float, std::int32_t>> Classify(const std::string& image_path, Worker* worker);
+
+    /// @brief Interpreter Pool
+    InterpreterPool* pool_;
+
+    /// @brief Input Mean resp. StdDev
+    float input_mean_;
+    float input_std_;
+
+    /// @brief Number of Results per image
+    std::int32_t number_of_results_;
+
+    /// @brief Number of Worker Threads
+    std::size_t number_of_workers_;
+
+    /// @brief Model Input metadata (read once, same for all interpreters)
+    TfLiteType input_type_;
+    TfLiteQuantizationParams input_params_;
+    ImageDimensions input_dims_;
+    std::size_t input_bytes_;
+
+    /// @brief Next unclaimed image index of current Run()
+    std::atomic<std::size_t> next_index_;
+
+    /// @brief Serializes callbacks and statistics updates
+    std::mutex result_mutex_;
+
+    /// @brief Statistics of current Run()
+    BatchStatistics statistics_;
+
+    /// @brief First failure of a callback, stops all the workers
+    std::exception_ptr error_;
+};
+
+}  // namespace perception
+#endif  /// PERCEPTION_INFERENCE_ENGINE_BATCH_CLASSIFIER_H_
@@ -0,0 +1,60 @@
+///
+/// @file batch_result_writer.h
+/// @brief Contains class definitions for Batch Result Writer (JSONL or CSV)
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_INFERENCE_ENGINE_BATCH_RESULT_WRITER_H_
+#define PERCEPTION_INFERENCE_ENGINE_BATCH_RESULT_WRITER_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "perception/inference_engine/batch_classifier.h"
+#include "perception/utils/label_table.h"
+
+namespace perception
+{
+/// @brief Streams Batch Results to single file, format picked by extension:
+///
+///  - .csv: header, then one row per (image, rank), i.e. image,rank,index,label,confidence,latency_ms,error
+///          (failed images get a single row with empty rank/index/label/confidence)
+///  - otherwise JSON Lines, one object per image, i.e.
+///          {"image": .., "latency_ms": .., "results": [{"index": .., "label": .., "confidence": ..}], "error": ..}
+///          ("error" only for failed images)
+class BatchResultWriter
+{
+  public:
+    /// @brief Output Format
+    enum class Format : std::int32_t
+    {
+        kJsonLines = 0,
+        kCsv = 1
+    };
+
+    /// @brief Constructor, truncates the file
+    /// @param [in] path - Output File Path
+    /// @param [in] labels - Labels (must outlive the writer)
+    /// @throws std::runtime_error if file can not be opened
+    BatchResultWriter(const std::string& path, const LabelTable& labels);
+
+    /// @brief Writes result of single image
+    /// @throws std::runtime_error if file can not be written
+    void Write(const BatchResult& result);
+
+    /// @brief Provides Output Format
+    Format GetFormat() const;
+
+  private:
+    /// @brief Output File
+    std::ofstream file_;
+
+    /// @brief Output Format
+    Format format_;
+
+    /// @brief Labels
+    const LabelTable& labels_;
+};
+
+}  // namespace perception
+#endif  /// PERCEPTION_INFERENCE_ENGINE_BATCH_RESULT_WRITER_H_
@@ -0,0 +1,60 @@
+///
+/// @file delegate_registry.h
+/// @brief Contains Delegate Registry (name -> TFLite delegate factory)
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_INFERENCE_ENGINE_DELEGATE_REGISTRY_H_
+#define PERCEPTION_INFERENCE_ENGINE_DELEGATE_REGISTRY_H_
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/interpreter.h"
+
+namespace perception
+{
+/// @brief Delegate Registry, which maps delegate names (i.e. CLIOptions::delegate) to delegate factories.
+///
+/// "none" (no delegate) and "nnapi" are registered by default. Custom delegates are registered once at startup,
+/// i.e. DelegateRegistry::GetInstance().Register("my_delegate", CreateMyDelegate), and selected by name.
+class DelegateRegistry
+{
+  public:
+    /// @brief Delegate factory, returns nullptr if delegate is not available on this platform
+    using DelegateFactory = std::function<tflite::Interpreter::TfLiteDelegatePtr()>;
+
+    /// @brief Name of the "no delegate" entry
+    static constexpr const char* kNoDelegate = "none";
+
+    /// @brief Provides process wide registry
+    static DelegateRegistry& GetInstance();
+
+    /// @brief Registers (or replaces) delegate factory
+    /// @param [in] name - Delegate Name
+    /// @param [in] factory - Delegate Factory
+    void Register(const std::string& name, const DelegateFactory& factory);
+
+    /// @brief Creates delegate registered with given name
+    /// @throws std::runtime_error if no delegate is registered with given name
+    /// @return delegate (nullptr for "none", or if delegate is not available on this platform)
+    tflite::Interpreter::TfLiteDelegatePtr Create(const std::string& name) const;
+
+    /// @brief Provides names of registered delegates
+    std::vector<std::string> GetNames() const;
+
+  private:
+    /// @brief Constructor (registers default delegates)
+    DelegateRegistry();
+
+    /// @brief Delegate factories, keyed by name
+    std::map<std::string, DelegateFactory> factories_;
+
+    /// @brief Guards factories
+    mutable std::mutex mutex_;
+};
+
+}  // namespace perception
+#endif  /// PERCEPTION_INFERENCE_ENGINE_DELEGATE_REGISTRY_H_
@@ -6,6 +6,7 @@
 #ifndef PERCEPTION_INFERENCE_ENGINE_INFERENCE_ENGINE_BASE_H_
 #define PERCEPTION_INFERENCE_ENGINE_INFERENCE_ENGINE_BASE_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -13,8 +14,10 @@
 #include <vector>
 
 #include "perception/argument_parser/cli_options.h"
+#include "perception/image_helper/decoded_image.h"
 #include "perception/image_helper/i_image_helper.h"
 #include "perception/inference_engine/i_inference_engine.h"
+#include "perception/utils/label_table.h"
 
 namespace perception
 {
@@ -36,8 +39,20 @@ class InferenceEngineBase : public IInferenceEngine
     /// @brief Provides Decoded Image Data
     virtual std::vector<std::uint8_t> GetImageData();
 
-    /// @brief Provides Labels List
-    virtual std::vector<std::string> GetLabelList() const;
+    /// @brief Provides Decoded Image Data, without copying it (valid until next GetImageData/GetImageView)
+    virtual const std::uint8_t* GetImageView();
+
+    /// @brief Set minimum size of decoded images (i.e. model input size), see IImageHelper::SetMinimumSize()
+    virtual void SetImageMinimumSize(const std::int32_t width, const std::int32_t height);
+
+    /// @brief Set luma only read of images (i.e. single channel model input), see IImageHelper::SetLumaOnly()
+    virtual void SetImageLumaOnly(const bool luma_only);
+
+    /// @brief Loads Labels (text or prebuilt binary file, see LabelTable), i.e. once per Init()
+    virtual void LoadLabels();
+
+    /// @brief Provides Labels, loaded by LoadLabels()
+    virtual const LabelTable& GetLabels() const;
 
     /// @brief Provides Image Width
     virtual std::int32_t GetImageWidth() const;
@@ -88,6 +103,42 @@ class InferenceEngineBase : public IInferenceEngine
     /// @brief Reads CLI Option for result directory
     virtual std::string GetResultDirectory() const;
 
+    /// @brief Reads CLI Option for Benchmark Mode Enabled?
+    /// @return true if cli arg `--benchmark` is set to 1, else false.
+    virtual bool IsBenchmarkEnabled() const;
+
+    /// @brief Reads CLI Option for Number of warmup runs (Benchmark Mode)
+    virtual std::int32_t GetWarmupRuns() const;
+
+    /// @brief Reads CLI Option for Pipeline Mode Enabled?
+    /// @return true if cli arg `--pipeline` is set to 1, else false.
+    virtual bool IsPipelineEnabled() const;
+
+    /// @brief Reads CLI Option for Number of threads to use for JPEG decode
+    virtual std::int32_t GetNumberOfDecodeThreads() const;
+
+    /// @brief Reads CLI Option for Region of interest within images
+    virtual RegionOfInterest GetRegionOfInterest() const;
+
+    /// @brief Reads CLI Option for Delegate Name
+    virtual std::string GetDelegateName() const;
+
+    /// @brief Reads CLI Option for Input Cache Size in bytes (0 if disabled)
+    virtual std::size_t GetInputCacheSize() const;
+
+    /// @brief Reads CLI Option for Batch Mode Enabled?
+    /// @return true if cli arg `--batch` is set, else false.
+    virtual bool IsBatchModeEnabled() const;
+
+    /// @brief Reads CLI Option for Batch Input (directory or manifest file)
+    virtual std::string GetBatchInput() const;
+
+    /// @brief Reads CLI Option for Number of workers (Batch Mode)
+    virtual std::int32_t GetBatchWorkers() const;
+
+    /// @brief Reads CLI Option for Batch Output file name (within result directory)
+    virtual std::string GetBatchOutput() const;
+
   private:
     /// @brief Command Line Interface Options
     CLIOptions cli_options_;
@@ -107,6 +158,9 @@ class InferenceEngineBase : public IInferenceEngine
 
     /// @brief Image Reader Helper
     std::unique_ptr<IImageHelper> image_helper_;
+
+    /// @brief Labels
+    LabelTable labels_;
 };
 
 }  // namespace perception
@@ -0,0 +1,143 @@
+///
+/// @file interpreter_pool.h
+/// @brief Contains class definitions for Interpreter Pool (K interpreters sharing one model)
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_INFERENCE_ENGINE_INTERPRETER_POOL_H_
+#define PERCEPTION_INFERENCE_ENGINE_INTERPRETER_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model.h"
+
+namespace perception
+{
+/// @brief Interpreter Pool, which maps the model once (or shares an already mapped one) and builds K interpreters on
+///        top of it.
+///
+/// Interpreters are handed out to worker threads through a lock-free checkout (one atomic flag per interpreter),
+/// and returned automatically once the Lease goes out of scope. Acquire() only takes a lock when all of them are in
+/// use, i.e. sleeps until one is returned instead of spinning. Each interpreter owns its tensor arena, so leased
+/// interpreters can be invoked concurrently; model weights are shared (read-only).
+///
+/// @note Threads per interpreter trades intra-op parallelism against number of concurrent requests, i.e. on a
+///       32 core machine, 8 interpreters x 4 threads or 32 interpreters x 1 thread.
+class InterpreterPool
+{
+  public:
+    /// @brief Checked out Interpreter, returned to the pool on destruction
+    class Lease
+    {
+      public:
+        /// @brief Default Constructor (i.e. empty lease)
+        Lease();
+
+        /// @brief Constructor
+        /// @param [in] pool - Owning Pool
+        /// @param [in] index - Checked out Interpreter Index
+        Lease(InterpreterPool* pool, const std::size_t index);
+
+        /// @brief Move Constructor
+        Lease(Lease&& other) noexcept;
+
+        /// @brief Move Assignment
+        Lease& operator=(Lease&& other) noexcept;
+
+        /// @brief Destructor (returns Interpreter to the pool)
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        /// @brief Provides checked out Interpreter (nullptr if empty lease)
+        tflite::Interpreter* get() const;
+
+        /// @brief Access checked out Interpreter
+        tflite::Interpreter* operator->() const;
+
+        /// @brief Holds an Interpreter?
+        explicit operator bool() const;
+
+        /// @brief Returns Interpreter to the pool, before end of scope
+        void Reset();
+
+      private:
+        /// @brief Owning Pool
+        InterpreterPool* pool_;
+
+        /// @brief Checked out Interpreter Index
+        std::size_t index_;
+    };
+
+    /// @brief Constructor
+    /// @param [in] model_path - Model Path (.tflite)
+    /// @param [in] number_of_interpreters - Number of Interpreters (K)
+    /// @param [in] threads_per_interpreter - Number of threads per Interpreter (-1 to leave TFLite default)
+    InterpreterPool(const std::string& model_path, const std::size_t number_of_interpreters,
+                    const std::int32_t threads_per_interpreter);
+
+    /// @brief Constructor, sharing an already mapped model (i.e. the one of the inference engine)
+    /// @param [in] model - Model (must outlive the pool)
+    /// @param [in] number_of_interpreters - Number of Interpreters (K)
+    /// @param [in] threads_per_interpreter - Number of threads per Interpreter (-1 to leave TFLite default)
+    InterpreterPool(const tflite::FlatBufferModel& model, const std::size_t number_of_interpreters,
+                    const std::int32_t threads_per_interpreter);
+
+    /// @brief Destructor
+    ~InterpreterPool();
+
+    /// @brief Checkout an Interpreter, if one is available
+    /// @return Lease (empty lease, if all interpreters are in use)
+    Lease TryAcquire();
+
+    /// @brief Checkout an Interpreter, waits (blocked, not spinning) until one is available
+    Lease Acquire();
+
+    /// @brief Provides Number of Interpreters (K)
+    std::size_t GetSize() const;
+
+    /// @brief Provides Number of Interpreters currently available for checkout
+    std::size_t GetAvailableCount() const;
+
+    /// @brief Provides shared Model
+    const tflite::FlatBufferModel& GetModel() const;
+
+  private:
+    /// @brief Builds K Interpreters on top of the model
+    void BuildInterpreters(const std::size_t number_of_interpreters, const std::int32_t threads_per_interpreter);
+
+    /// @brief Returns Interpreter to the pool
+    void Release(const std::size_t index);
+
+    /// @brief TFLite Model Buffer Instance, if mapped by the pool itself
+    std::unique_ptr<tflite::FlatBufferModel> owned_model_;
+
+    /// @brief TFLite Model Buffer Instance (shared by all interpreters)
+    const tflite::FlatBufferModel* model_;
+
+    /// @brief TFLite Model Interpreter instances
+    std::vector<std::unique_ptr<tflite::Interpreter>> interpreters_;
+
+    /// @brief In use flag, per Interpreter
+    std::unique_ptr<std::atomic<bool>[]> in_use_;
+
+    /// @brief Index to start next checkout from (spreads contention across flags)
+    std::atomic<std::size_t> next_;
+
+    /// @brief Wakes up Acquire() waiters, once Release() returns an Interpreter
+    std::mutex mutex_;
+    std::condition_variable interpreter_available_;
+
+    /// @brief Number of Acquire() waiters, i.e. Release() only notifies if there is one
+    std::atomic<std::size_t> waiters_;
+};
+
+}  // namespace perception
+#endif  /// PERCEPTION_INFERENCE_ENGINE_INTERPRETER_POOL_H_
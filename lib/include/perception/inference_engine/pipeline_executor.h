@@ -0,0 +1,169 @@
+///
+/// @file pipeline_executor.h
+/// @brief Contains class definitions for Pipeline Executor (decode / preprocess / invoke / postprocess)
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_INFERENCE_ENGINE_PIPELINE_EXECUTOR_H_
+#define PERCEPTION_INFERENCE_ENGINE_PIPELINE_EXECUTOR_H_
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/interpreter.h"
+
+#include "perception/image_helper/decoded_image.h"
+#include "perception/inference_engine/preprocessing_engine.h"
+#include "perception/utils/spsc_queue.h"
+
+namespace perception
+{
+/// @brief Result of single frame
+struct PipelineResult
+{
+    /// @brief Frame Index (i.e. position in the input list)
+    std::size_t frame_index;
+
+    /// @brief Image Path
+    std::string image_path;
+
+    /// @brief vector of pair of (confidence, label idx)
+    std::vector<std::pair<float, std::int32_t>> results;
+};
+
+/// @brief Statistics of single pipeline stage
+struct StageStatistics
+{
+    /// @brief Stage Name
+    std::string name;
+
+    /// @brief Number of processed frames
+    std::size_t frames;
+
+    /// @brief Time spent processing frames (ms), i.e. excluding waits on input/output queues
+    double busy_time_ms;
+
+    /// @brief Busy time / pipeline wall time [0, 1]. The stage closest to 1 is the bottleneck.
+    double occupancy;
+
+    /// @brief Average number of frames waiting in the stage input queue (sampled on every frame)
+    double average_queue_size;
+};
+
+/// @brief Pipeline Executor, which runs decode, preprocess, invoke and postprocess stages on their own threads.
+///
+/// Stages are connected by bounded SPSC ring buffers, so that a slow stage applies backpressure on the stages
+/// before it. Frames carry their own input/output tensor copies, thus decode/preprocess of frame N+1 overlaps
+/// with invoke of frame N, while only the invoke stage ever touches the interpreter.
+class PipelineExecutor
+{
+  public:
+    /// @brief Callback invoked (on the postprocess thread) for each frame result, in frame order
+    using ResultCallback = std::function<void(const PipelineResult&)>;
+
+    /// @brief Constructor
+    /// @param [in] interpreter - Interpreter with allocated tensors (used by the invoke stage only)
+    /// @param [in] input_mean - Input Mean
+    /// @param [in] input_std - Input StdDev
+    /// @param [in] number_of_results - Number of Results per frame
+    /// @param [in] queue_capacity - Capacity of each inter-stage queue
+    PipelineExecutor(tflite::Interpreter* interpreter, const float input_mean, const float input_std,
+                     const std::int32_t number_of_results, const std::size_t queue_capacity);
+
+    /// @brief Destructor
+    ~PipelineExecutor();
+
+    /// @brief Set number of threads used by the decode stage to decode single image, see
+    ///        IImageHelper::SetNumberOfThreads()
+    /// @param [in] number_of_threads - Number of Threads (1 for serial decode)
+    void SetNumberOfDecodeThreads(const std::int32_t number_of_threads);
+
+    /// @brief Set region of interest read by the decode stage, see IImageHelper::SetRegionOfInterest()
+    /// @param [in] region_of_interest - Region of Interest (0 width/height for whole image)
+    void SetRegionOfInterest(const RegionOfInterest& region_of_interest);
+
+    /// @brief Runs all the images through the pipeline
+    /// @param [in] image_paths - Image Paths (BMP or JPEG)
+    /// @param [in] callback - Callback for each frame result (i.e. file writes), optional
+    /// @return Results, in frame order
+    std::vector<PipelineResult> Run(const std::vector<std::string>& image_paths,
+                                    const ResultCallback& callback = nullptr);
+
+    /// @brief Provides per-stage statistics of last Run()
+    std::vector<StageStatistics> GetStageStatistics() const;
+
+  private:
+    /// @brief Frame travelling through the pipeline
+    struct Frame
+    {
+        /// @brief Frame Index
+        std::size_t index;
+
+        /// @brief Decoded Image
+        DecodedImage image;
+
+        /// @brief Model Input (after preprocess) or Model Output (after invoke) bytes
+        std::vector<std::uint8_t> tensor;
+    };
+
+    /// @brief Per stage bookkeeping, updated by stage thread
+    struct StageCounters
+    {
+        std::size_t frames;
+        double busy_time_ms;
+        std::size_t queue_size_sum;
+    };
+
+    /// @brief Stages (each one runs on its own thread)
+    void Decode(const std::vector<std::string>& image_paths, SpscQueue<Frame>* output);
+    void Preprocess(SpscQueue<Frame>* input, SpscQueue<Frame>* output);
+    void Invoke(SpscQueue<Frame>* input, SpscQueue<Frame>* output);
+    void Postprocess(const std::vector<std::string>& image_paths, const ResultCallback& callback,
+                     SpscQueue<Frame>* input, std::vector<PipelineResult>* results);
+
+    /// @brief Stores first failure and unblocks all the stages
+    void Abort(const std::exception_ptr& error);
+
+    /// @brief TFLite Model Interpreter
+    tflite::Interpreter* interpreter_;
+
+    /// @brief Preprocessing Engine (used by preprocess stage only)
+    PreprocessingEngine preprocessing_engine_;
+
+    /// @brief Number of Results per frame
+    std::int32_t number_of_results_;
+
+    /// @brief Model Input metadata (read once, so that preprocess never touches the interpreter)
+    TfLiteType input_type_;
+    TfLiteQuantizationParams input_params_;
+    ImageDimensions input_dims_;
+    std::size_t input_bytes_;
+
+    /// @brief Capacity of each inter-stage queue
+    std::size_t queue_capacity_;
+
+    /// @brief Image read settings of the decode stage
+    std::int32_t decode_threads_;
+    RegionOfInterest region_of_interest_;
+
+    /// @brief Per stage counters (decode, preprocess, invoke, postprocess)
+    StageCounters counters_[4];
+
+    /// @brief Wall time of last Run() (ms)
+    double wall_time_ms_;
+
+    /// @brief First failure within any of the stages
+    std::exception_ptr error_;
+    std::mutex error_mutex_;
+
+    /// @brief Set on failure, stops all the stages
+    std::atomic<bool> aborted_;
+};
+
+}  // namespace perception
+#endif  /// PERCEPTION_INFERENCE_ENGINE_PIPELINE_EXECUTOR_H_
@@ -0,0 +1,135 @@
+///
+/// @file preprocessing_engine.h
+/// @brief Contains class definitions for Preprocessing Engine (Resize + Normalization)
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_INFERENCE_ENGINE_PREPROCESSING_ENGINE_H_
+#define PERCEPTION_INFERENCE_ENGINE_PREPROCESSING_ENGINE_H_
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "tensorflow/lite/interpreter.h"
+
+#include "perception/utils/resize_bilinear.h"
+
+namespace perception
+{
+/// @brief Image/Tensor Dimensions (batch is always 1)
+struct ImageDimensions
+{
+    /// @brief Height
+    std::int32_t height;
+
+    /// @brief Width
+    std::int32_t width;
+
+    /// @brief Channels
+    std::int32_t channels;
+};
+
+/// @brief Preprocessing Engine, which resizes decoded image to the model input size.
+///
+/// @note The resize kernel is built once per (source shape, target shape, output type) and cached, so that
+///       a stream of same sized frames never rebuilds (or reallocates) anything. Resize, channel handling and
+///       normalization are done in one pass by BilinearResizer, straight into the provided output.
+///
+/// @note Quantized outputs (uint8/int8) stay in integer arithmetic; normalization and quantization are folded into
+///       a lookup table, rebuilt only when the quantization parameters change.
+class PreprocessingEngine
+{
+  public:
+    /// @brief Constructor
+    /// @param [in] input_mean - Input Mean (used only for floating point outputs)
+    /// @param [in] input_std - Input StdDev (used only for floating point outputs)
+    explicit PreprocessingEngine(const float input_mean, const float input_std);
+
+    /// @brief Destructor
+    ~PreprocessingEngine();
+
+    /// @brief Resize and Normalize image into floating point output, i.e. (x - input_mean) / input_std
+    /// @param [in] input - Decoded Image Data (HWC)
+    /// @param [in] input_dims - Decoded Image Dimensions
+    /// @param [in] output_dims - Wanted Dimensions
+    /// @param [out] output - Output buffer (i.e. model input tensor)
+    void Resize(const std::uint8_t* input, const ImageDimensions& input_dims, const ImageDimensions& output_dims,
+                float* output);
+
+    /// @brief Resize image into uint8 output
+    /// @param [in] input - Decoded Image Data (HWC)
+    /// @param [in] input_dims - Decoded Image Dimensions
+    /// @param [in] output_dims - Wanted Dimensions
+    /// @param [out] output - Output buffer (i.e. model input tensor)
+    void Resize(const std::uint8_t* input, const ImageDimensions& input_dims, const ImageDimensions& output_dims,
+                std::uint8_t* output);
+
+    /// @brief Resize, Normalize and Quantize image into uint8 output, i.e.
+    ///        round(((x - input_mean) / input_std) / params.scale) + params.zero_point
+    /// @param [in] input - Decoded Image Data (HWC)
+    /// @param [in] input_dims - Decoded Image Dimensions
+    /// @param [in] output_dims - Wanted Dimensions
+    /// @param [in] params - Quantization parameters of the output (i.e. model input tensor)
+    /// @param [out] output - Output buffer (i.e. model input tensor)
+    void Resize(const std::uint8_t* input, const ImageDimensions& input_dims, const ImageDimensions& output_dims,
+                const TfLiteQuantizationParams& params, std::uint8_t* output);
+
+    /// @brief Resize, Normalize and Quantize image into int8 output, i.e.
+    ///        round(((x - input_mean) / input_std) / params.scale) + params.zero_point
+    /// @param [in] input - Decoded Image Data (HWC)
+    /// @param [in] input_dims - Decoded Image Dimensions
+    /// @param [in] output_dims - Wanted Dimensions
+    /// @param [in] params - Quantization parameters of the output (i.e. model input tensor)
+    /// @param [out] output - Output buffer (i.e. model input tensor)
+    void Resize(const std::uint8_t* input, const ImageDimensions& input_dims, const ImageDimensions& output_dims,
+                const TfLiteQuantizationParams& params, std::int8_t* output);
+
+    /// @brief Provides number of cached resize kernels
+    std::size_t GetCacheSize() const;
+
+  private:
+    /// @brief Cache Key i.e. (source shape, target shape, output type)
+    using CacheKey = std::tuple<std::int32_t, std::int32_t, std::int32_t, std::int32_t, std::int32_t, std::int32_t,
+                                std::int32_t>;
+
+    /// @brief Provides (or builds) resize kernel for given source/target shape
+    BilinearResizer* GetResizer(const ImageDimensions& input_dims, const ImageDimensions& output_dims,
+                                const TfLiteType output_type);
+
+    /// @brief Quantization table (pixel value -> quantized value) for given quantization parameters
+    template <typename T>
+    struct QuantizationTable
+    {
+        /// @brief Quantization parameters the table was built for
+        float scale;
+        std::int32_t zero_point;
+
+        /// @brief Built at least once?
+        bool valid;
+
+        /// @brief Quantized value, per pixel value
+        std::array<T, 256> values;
+    };
+
+    /// @brief Provides (or rebuilds) quantization table for given quantization parameters
+    template <typename T>
+    const T* GetQuantizationTable(const TfLiteQuantizationParams& params, QuantizationTable<T>* table) const;
+
+    /// @brief Input Mean
+    float input_mean_;
+
+    /// @brief Input StdDev
+    float input_std_;
+
+    /// @brief Resize kernels, keyed by shape
+    std::map<CacheKey, std::unique_ptr<BilinearResizer>> cache_;
+
+    /// @brief Quantization tables, per output type
+    QuantizationTable<std::uint8_t> uint8_table_;
+    QuantizationTable<std::int8_t> int8_table_;
+};
+
+}  // namespace perception
+#endif  /// PERCEPTION_INFERENCE_ENGINE_PREPROCESSING_ENGINE_H_
@@ -7,6 +7,7 @@
 #define PERCEPTION_INFERENCE_ENGINE_TFLITE_INFERENCE_ENGINE_H_
 
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -14,10 +15,15 @@
 
 #include "tensorflow/lite/interpreter.h"
 #include "tensorflow/lite/model.h"
+#include "tensorflow/lite/op_resolver.h"
 
 #include "perception/argument_parser/cli_options.h"
+#include "perception/image_helper/decoded_image.h"
 #include "perception/image_helper/i_image_helper.h"
 #include "perception/inference_engine/inference_engine_base.h"
+#include "perception/inference_engine/preprocessing_engine.h"
+#include "perception/utils/async_result_writer.h"
+#include "perception/utils/input_cache.h"
 
 namespace perception
 {
@@ -44,6 +50,22 @@ class TFLiteInferenceEngine : public InferenceEngineBase
     /// @brief Release TFLite Inference Engine
     virtual void Shutdown() override;
 
+    /// @brief Execute batched Inference, i.e. packs all the images into input tensor of [N, H, W, C] and
+    ///        invokes the interpreter once.
+    /// @note  Interpreter (and its tensor arena) is allocated once per batch size and reused afterwards.
+    /// @param [in] images - Decoded Images
+    /// @return Results per image, i.e. vector of pair of (confidence, label idx)
+    virtual std::vector<std::vector<std::pair<float, std::int32_t>>> ExecuteBatch(
+        const std::vector<DecodedImage>& images);
+
+    /// @brief Execute Inference for stream of images, with decode, preprocess, invoke and postprocess stages running
+    ///        concurrently (i.e. decode of frame N+1 overlaps with invoke of frame N). Logs per-stage occupancy.
+    ///        Images are read with the CLI Options of single image reads (region of interest, decode threads).
+    /// @param [in] image_paths - Image Paths (BMP or JPEG)
+    /// @return Results per image (in order), i.e. vector of pair of (confidence, label idx)
+    virtual std::vector<std::vector<std::pair<float, std::int32_t>>> ExecutePipeline(
+        const std::vector<std::string>& image_paths);
+
   protected:
     /// @brief Obtain Intermediate Layers/Operations Output
     /// @return vector of pair of (filename, file content)
@@ -57,14 +79,87 @@ class TFLiteInferenceEngine : public InferenceEngineBase
     /// @brief Invokes Inference with TFLite Interpreter
     virtual void InvokeInference();
 
+    /// @brief Appends result of current frame to results file (asynchronously, see AsyncResultWriter)
+    /// @param [in] name - Result Name (i.e. former file name)
+    /// @param [in] content - Result Content
+    void SaveResult(const std::string& name, std::string content);
+
+    /// @brief Runs warmup and loop_count measured iterations of decode, preprocess, invoke and postprocess, then
+    ///        reports per-stage latency statistics (logged and written to benchmark.json in result directory)
+    virtual void RunBenchmark();
+
+    /// @brief Classifies all the images of batch input (directory or manifest) on a pool of workers, streams results
+    ///        to batch output file and reports throughput and per image latency (logged and written to
+    ///        batch_statistics.json in result directory)
+    virtual void RunBatch();
+
+    /// @brief Streams loop_count frames of the input image through ExecutePipeline(), then reports throughput and
+    ///        top results of the last frame (results of each frame are saved, if enabled)
+    virtual void RunPipeline();
+
     /// @brief Set Image Data to Model Input (via Interpreter)
-    virtual void SetInputData(const std::vector<std::uint8_t>& image_data);
+    virtual void SetInputData(const std::uint8_t* image_data);
+
+    /// @brief Set Model Input from input cache, if the image has been preprocessed before (and not modified since)
+    /// @param [out] key - Input cache key of the image, for CacheInputData() on a miss
+    /// @return true on cache hit, false on miss (or if input cache is disabled)
+    bool SetCachedInputData(InputCacheKey* key);
+
+    /// @brief Stores Model Input (i.e. preprocessed image) within input cache, if enabled
+    /// @param [in] key - Input cache key of the image (see SetCachedInputData())
+    void CacheInputData(const InputCacheKey& key);
+
+    /// @brief Set Image Data to given batch slot of the Model Input
+    /// @param [in] interpreter - Interpreter, which owns the Model Input
+    /// @param [in] batch_index - Batch slot to be filled
+    /// @param [in] image_data - Decoded Image Data (HWC)
+    /// @param [in] image_dims - Decoded Image Dimensions
+    void SetInputData(tflite::Interpreter* interpreter, const std::int32_t batch_index,
+                      const std::uint8_t* image_data, const ImageDimensions& image_dims);
+
+    /// @brief Obtain Results for given batch slot of the Model Output
+    /// @param [in] interpreter - Interpreter, which owns the Model Output
+    /// @param [in] batch_index - Batch slot to be read
+    /// @return vector of pair of (confidence, label idx)
+    std::vector<std::pair<float, std::int32_t>> GetResults(tflite::Interpreter* interpreter,
+                                                           const std::int32_t batch_index) const;
+
+    /// @brief Builds Interpreter for the loaded Model
+    std::unique_ptr<tflite::Interpreter> BuildInterpreter() const;
+
+    /// @brief Applies selected delegate (see DelegateRegistry) to the Interpreter. Falls back to builtin kernels, if
+    ///        delegate is unavailable or rejects the graph.
+    void ApplyDelegate();
+
+    /// @brief Provides (or builds) Interpreter with Model Input resized to given batch size
+    tflite::Interpreter* GetInterpreter(const std::int32_t batch_size);
 
     /// @brief TFLite Model Buffer Instance
     std::unique_ptr<tflite::FlatBufferModel> model_;
 
+    /// @brief Op Resolver (builtin or model specific, selected at link time)
+    std::unique_ptr<tflite::OpResolver> op_resolver_;
+
+    /// @brief Applied Delegate (declared before interpreter_, as it must outlive the interpreter)
+    tflite::Interpreter::TfLiteDelegatePtr delegate_;
+
     /// @brief TFLite Model Interpreter instance
     std::unique_ptr<tflite::Interpreter> interpreter_;
+
+    /// @brief TFLite Model Interpreter instances, keyed by batch size (batch size > 1, builtin kernels only)
+    std::map<std::int32_t, std::unique_ptr<tflite::Interpreter>> batch_interpreters_;
+
+    /// @brief Preprocessing Engine (persistent across frames)
+    PreprocessingEngine preprocessing_engine_;
+
+    /// @brief Preprocessed Model Inputs of recently executed images
+    InputCache input_cache_;
+
+    /// @brief Writer of results file (save results only)
+    std::unique_ptr<AsyncResultWriter> result_writer_;
+
+    /// @brief Index of current frame, i.e. number of completed Execute() calls
+    std::size_t frame_index_;
 };
 
 }  // namespace perception
@@ -0,0 +1,30 @@
+///
+/// @file top_results.h
+/// @brief Contains Top N Results extraction from Model Output
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_INFERENCE_ENGINE_TOP_RESULTS_H_
+#define PERCEPTION_INFERENCE_ENGINE_TOP_RESULTS_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/interpreter.h"
+
+namespace perception
+{
+/// @brief Provides Top N Results (over threshold) of single batch slot of Model Output
+/// @param [in] type - Model Output type (float32, uint8 or int8)
+/// @param [in] params - Model Output quantization parameters (used for uint8 and int8, uint8 without them is
+///                      dequantized as score / 255)
+/// @param [in] data - Model Output data, for the batch slot
+/// @param [in] size - Number of classes
+/// @param [in] number_of_results - Number of Results (N)
+/// @return vector of pair of (confidence, label idx), sorted by confidence in descending order
+std::vector<std::pair<float, std::int32_t>> GetTopResults(const TfLiteType type, const TfLiteQuantizationParams& params,
+                                                          const void* data, const std::int32_t size,
+                                                          const std::int32_t number_of_results);
+
+}  // namespace perception
+#endif  /// PERCEPTION_INFERENCE_ENGINE_TOP_RESULTS_H_
@@ -0,0 +1,25 @@
+///
+/// @file op_resolver.h
+/// @brief Contains Op Resolver factory, which is resolved at link time
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_OP_RESOLVER_OP_RESOLVER_H_
+#define PERCEPTION_OP_RESOLVER_OP_RESOLVER_H_
+
+#include <memory>
+
+#include "tensorflow/lite/op_resolver.h"
+
+namespace perception
+{
+/// @brief Creates Op Resolver used to build interpreters.
+///
+/// Implementation is selected by linking exactly one of
+///   - //lib:builtin_op_resolver, i.e. tflite::ops::builtin::BuiltinOpResolver (all builtin kernels), or
+///   - tflite_op_resolver(name, model) target (see bazel/rules/op_resolver.bzl), i.e. only the kernels used by
+///     the given model, which cuts binary size and time spent resolving ops at startup.
+std::unique_ptr<tflite::OpResolver> CreateOpResolver();
+
+}  // namespace perception
+
+#endif  /// PERCEPTION_OP_RESOLVER_OP_RESOLVER_H_
@@ -37,7 +37,8 @@ class Perception
     /// @brief Initialise Inference Engine
     virtual void Init();
 
-    /// @brief Executes Inference Engine for given Image, n times. n=cli.loop_count
+    /// @brief Executes Inference Engine for given Image, n times. n=cli.loop_count (once in benchmark, batch
+    ///        resp. pipeline mode)
     virtual void Execute();
 
     /// @brief Release Inference Engine
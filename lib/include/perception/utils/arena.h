@@ -0,0 +1,72 @@
+///
+/// @file arena.h
+/// @brief Contains Arena (bump allocator) for per-image buffers
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_ARENA_H_
+#define PERCEPTION_UTILS_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace perception
+{
+/// @brief Arena for buffers living as long as single image (i.e. decoder planes and scratch). Allocations are carved
+///        out of one block and released all at once by Reset(). Once the block runs out, allocations fall back to the
+///        heap and the next Reset() grows the block to fit all of them, thus a stream of similar sized images settles
+///        on a block which is never reallocated (i.e. zero heap allocations per image).
+class Arena
+{
+  public:
+    /// @brief Alignment of allocations (cache line, i.e. no false sharing between threads)
+    static constexpr std::size_t kAlignment = 64U;
+
+    /// @brief Constructor
+    /// @param [in] capacity - Initial block size in bytes (0 to size it by the first Reset())
+    explicit Arena(const std::size_t capacity = 0U);
+
+    /// @brief Destructor (releases block and fallback allocations)
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /// @brief Allocates size bytes, can be called from multiple threads at once.
+    /// @return buffer, valid until next Reset() (nullptr if out of memory)
+    void* Allocate(const std::size_t size);
+
+    /// @brief Releases all allocations and grows block if allocations did not fit since last Reset(). Must not run
+    ///        concurrently with Allocate().
+    void Reset();
+
+    /// @brief Provides block size in bytes
+    std::size_t GetCapacity() const;
+
+    /// @brief Provides number of heap allocations (block and fallbacks) since construction
+    std::size_t GetNumberOfHeapAllocations() const;
+
+  private:
+    /// @brief Block, aligned to kAlignment within block_memory_
+    std::uint8_t* block_memory_;
+    std::uint8_t* block_;
+    std::size_t capacity_;
+
+    /// @brief Bytes allocated since last Reset(), incl. fallbacks (i.e. may exceed capacity)
+    std::atomic<std::size_t> used_;
+
+    /// @brief Guards fallbacks_
+    std::mutex mutex_;
+
+    /// @brief Heap allocations which did not fit into the block
+    std::vector<void*> fallbacks_;
+
+    /// @brief Number of heap allocations since construction
+    std::atomic<std::size_t> heap_allocations_;
+};
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_ARENA_H_
@@ -0,0 +1,113 @@
+///
+/// @file async_result_writer.h
+/// @brief Contains Asynchronous Result Writer (dedicated writer thread, lock-free submission)
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_ASYNC_RESULT_WRITER_H_
+#define PERCEPTION_UTILS_ASYNC_RESULT_WRITER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "perception/utils/spsc_queue.h"
+
+namespace perception
+{
+/// @brief Appends records (i.e. per frame results) to single file on a dedicated writer thread, so that the
+///        submitting thread never waits for the disk.
+///
+/// Records are handed over through a lock-free SPSC ring buffer, thus Submit() must always be called from the same
+/// thread. The writer thread drains all the pending records at once and writes them with a single write, i.e. bursts
+/// of records (one per intermediate tensor) cost one write. Each record is preceded by a "### <name>" line. While
+/// there is nothing to write, the writer thread sleeps until Submit() or Close() wakes it up.
+///
+/// @note Submit() only waits (backpressure), if the queue is full.
+class AsyncResultWriter
+{
+  public:
+    /// @brief Constructor, truncates the file and starts the writer thread
+    /// @param [in] path - Output File Path
+    /// @param [in] queue_capacity - Maximum number of pending records
+    /// @throws std::runtime_error if file can not be opened
+    AsyncResultWriter(const std::string& path, const std::size_t queue_capacity);
+
+    /// @brief Destructor, writes pending records and stops the writer thread (failures are reported by Close() only)
+    ~AsyncResultWriter();
+
+    AsyncResultWriter(const AsyncResultWriter&) = delete;
+    AsyncResultWriter& operator=(const AsyncResultWriter&) = delete;
+
+    /// @brief Submits record to be appended (submitting thread only)
+    /// @param [in] name - Record Name (i.e. "frame 0: top_k_results.txt")
+    /// @param [in] content - Record Content
+    /// @throws std::runtime_error if writer is closed or failed
+    void Submit(const std::string& name, std::string content);
+
+    /// @brief Waits until all the submitted records are written (submitting thread only)
+    /// @throws std::runtime_error if writer failed
+    void Flush();
+
+    /// @brief Writes pending records and stops the writer thread, further submits are rejected
+    /// @throws std::runtime_error if writer failed
+    void Close();
+
+    /// @brief Provides number of written records resp. writes (batches of records)
+    std::size_t GetNumberOfRecords() const;
+    std::size_t GetNumberOfBatches() const;
+
+  private:
+    /// @brief Record, i.e. name and content
+    struct Record
+    {
+        std::string name;
+        std::string content;
+    };
+
+    /// @brief Writer thread loop
+    void Work();
+
+    /// @brief Rethrows writer failure, if any
+    void CheckError() const;
+
+    /// @brief Output File Path
+    std::string path_;
+
+    /// @brief Output File (writer thread only)
+    std::ofstream file_;
+
+    /// @brief Pending records
+    SpscQueue<Record> queue_;
+
+    /// @brief Guards wake-ups of writer thread resp. Flush(), i.e. updates of the waited for state
+    std::mutex mutex_;
+
+    /// @brief Notified on submitted records and Close() (wakes writer thread)
+    std::condition_variable records_submitted_;
+
+    /// @brief Notified on written records and writer failure (wakes Flush())
+    std::condition_variable records_written_;
+
+    /// @brief Number of submitted records (written by submitting thread only)
+    std::size_t submitted_;
+
+    /// @brief Number of written records resp. batches
+    std::atomic<std::size_t> written_;
+    std::atomic<std::size_t> batches_;
+
+    /// @brief Writer failure (set by writer thread, before failed_)
+    std::exception_ptr error_;
+    std::atomic<bool> failed_;
+
+    /// @brief Writer Thread
+    std::thread writer_;
+};
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_ASYNC_RESULT_WRITER_H_
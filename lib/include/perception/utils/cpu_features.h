@@ -0,0 +1,54 @@
+///
+/// @file cpu_features.h
+/// @brief Contains runtime CPU feature detection used to pick SIMD kernels
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_CPU_FEATURES_H_
+#define PERCEPTION_UTILS_CPU_FEATURES_H_
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PERCEPTION_X86_SIMD 1
+#endif
+
+namespace perception
+{
+/// @brief Instruction Sets (ordered, i.e. each level implies the previous ones)
+enum class InstructionSet : std::int32_t
+{
+    kScalar = 0,
+    kSse2 = 1,
+    kSsse3 = 2,
+    kSse41 = 3,
+    kAvx2 = 4
+};
+
+/// @brief Provides best Instruction Set supported by the running CPU
+inline InstructionSet GetSupportedInstructionSet()
+{
+#ifdef PERCEPTION_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return InstructionSet::kAvx2;
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return InstructionSet::kSse41;
+    }
+    if (__builtin_cpu_supports("ssse3"))
+    {
+        return InstructionSet::kSsse3;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return InstructionSet::kSse2;
+    }
+#endif
+    return InstructionSet::kScalar;
+}
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_CPU_FEATURES_H_
@@ -0,0 +1,105 @@
+///
+/// @file input_cache.h
+/// @brief Contains LRU Cache of preprocessed Model Inputs
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_INPUT_CACHE_H_
+#define PERCEPTION_UTILS_INPUT_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace perception
+{
+/// @brief Identifies preprocessed Model Input, i.e. image file (path, modification time and size) and input tensor
+///        (shape and type). Rewritten image files get a new key, thus stale entries are never hit.
+struct InputCacheKey
+{
+    /// @brief Image Path
+    std::string path;
+
+    /// @brief Image file modification time (ticks since epoch) and size in bytes
+    std::int64_t modification_time;
+    std::uint64_t file_size;
+
+    /// @brief Input tensor shape and type
+    std::vector<std::int32_t> shape;
+    std::int32_t type;
+
+    bool operator==(const InputCacheKey& other) const;
+};
+
+/// @brief Hash of InputCacheKey
+struct InputCacheKeyHash
+{
+    std::size_t operator()(const InputCacheKey& key) const;
+};
+
+/// @brief LRU Cache of preprocessed Model Inputs (tensor bytes). Memory use is bounded by capacity, least recently
+///        used entries are evicted first.
+/// @note  Preprocessing settings other than the input tensor (i.e. mean/std, region of interest) are not part of the
+///        key, thus a cache must not be shared between differently configured inference engines. Not thread-safe.
+class InputCache
+{
+  public:
+    /// @brief Constructor
+    /// @param [in] capacity - Maximum size of all cached tensors in bytes (0 disables caching)
+    explicit InputCache(const std::size_t capacity);
+
+    /// @brief Creates key of given image file and input tensor
+    /// @throws std::runtime_error (filesystem_error) if image file can not be accessed
+    static InputCacheKey MakeKey(const std::string& path, const std::vector<std::int32_t>& shape,
+                                 const std::int32_t type);
+
+    /// @brief Is caching enabled (i.e. capacity > 0)?
+    bool IsEnabled() const;
+
+    /// @brief Looks up cached tensor and marks it as most recently used
+    /// @return tensor bytes, valid until next Insert() (nullptr if not cached)
+    const std::vector<std::uint8_t>* Find(const InputCacheKey& key);
+
+    /// @brief Caches tensor as most recently used, evicting least recently used ones until it fits. Tensors larger
+    ///        than capacity are not cached.
+    void Insert(const InputCacheKey& key, const std::uint8_t* data, const std::size_t size);
+
+    /// @brief Provides size of all cached tensors in bytes
+    std::size_t GetSize() const;
+
+    /// @brief Provides number of cached tensors
+    std::size_t GetNumberOfEntries() const;
+
+    /// @brief Provides number of hits resp. misses of Find() since construction
+    std::size_t GetNumberOfHits() const;
+    std::size_t GetNumberOfMisses() const;
+
+  private:
+    using Entry = std::pair<InputCacheKey, std::vector<std::uint8_t>>;
+
+    /// @brief Evicts least recently used entries until size_ + size fits into capacity
+    void Evict(const std::size_t size);
+
+    /// @brief Maximum size of all cached tensors in bytes
+    std::size_t capacity_;
+
+    /// @brief Size of all cached tensors in bytes
+    std::size_t size_;
+
+    /// @brief Entries, most recently used first
+    std::list<Entry> entries_;
+
+    /// @brief Entries by key
+    std::unordered_map<InputCacheKey, std::list<Entry>::iterator, InputCacheKeyHash> index_;
+
+    /// @brief Find() statistics
+    std::size_t hits_;
+    std::size_t misses_;
+};
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_INPUT_CACHE_H_
@@ -0,0 +1,22 @@
+///
+/// @file json.h
+/// @brief Contains helpers for writing JSON output
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_JSON_H_
+#define PERCEPTION_UTILS_JSON_H_
+
+#include <ostream>
+
+#include "absl/strings/string_view.h"
+
+namespace perception
+{
+/// @brief Writes value as JSON string, i.e. quoted with quotes, backslashes and control characters escaped
+/// @param [in] stream - Output Stream
+/// @param [in] value - Value (i.e. file path or label)
+void WriteJsonString(std::ostream& stream, const absl::string_view value);
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_JSON_H_
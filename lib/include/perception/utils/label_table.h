@@ -0,0 +1,76 @@
+///
+/// @file label_table.h
+/// @brief Contains Label Table, i.e. labels of Model Output classes
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_LABEL_TABLE_H_
+#define PERCEPTION_UTILS_LABEL_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+#include "perception/utils/mapped_file.h"
+
+namespace perception
+{
+/// @brief Labels of Model Output classes, stored as single contiguous string (arena) with offset index, thus lookups
+///        neither allocate nor copy.
+///
+/// Labels are read from text file (one label per line) or from prebuilt binary file (see Save()), which is memory
+/// mapped and used in place, i.e. loads without parsing. Binary layout (native endianness):
+///
+///     "LBL1" | uint32 number_of_labels | uint32 offsets[number_of_labels + 1] | characters
+///
+/// where label i is characters [offsets[i], offsets[i + 1]).
+class LabelTable
+{
+  public:
+    /// @brief Magic number of binary label files
+    static constexpr char kMagic[4] = {'L', 'B', 'L', '1'};
+
+    /// @brief Constructor (empty table)
+    LabelTable();
+
+    /// @brief Loads labels from text or binary file (told apart by the magic number)
+    /// @param [in] path - Label File Path
+    /// @throws std::runtime_error if file can not be read or binary file is malformed
+    static LabelTable Load(const std::string& path);
+
+    /// @brief Writes labels to binary file (see Load())
+    /// @param [in] path - Binary Label File Path
+    /// @throws std::runtime_error if file can not be written
+    void Save(const std::string& path) const;
+
+    /// @brief Provides label of given class
+    /// @return label, valid as long as the table (empty for classes without label)
+    absl::string_view Get(const std::size_t index) const;
+
+    /// @brief Provides number of labels
+    std::size_t GetSize() const;
+
+  private:
+    /// @brief Provides characters resp. offsets, either owned by the table (text) or within mapping (binary)
+    const char* GetCharacters() const;
+    const std::uint32_t* GetOffsets() const;
+
+    /// @brief Characters of all the labels (text file)
+    std::string arena_;
+
+    /// @brief Offsets of labels within arena_, number of labels + 1 (text file)
+    std::vector<std::uint32_t> offsets_;
+
+    /// @brief Mapping of binary file, nullptr for text file
+    std::unique_ptr<MappedFile> mapping_;
+
+    /// @brief Number of labels
+    std::size_t size_;
+};
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_LABEL_TABLE_H_
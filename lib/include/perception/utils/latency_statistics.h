@@ -0,0 +1,59 @@
+///
+/// @file latency_statistics.h
+/// @brief Contains Latency Statistics (min/mean/percentiles/max and histogram)
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_LATENCY_STATISTICS_H_
+#define PERCEPTION_UTILS_LATENCY_STATISTICS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace perception
+{
+/// @brief Collects latency samples (ms) and summarizes them
+class LatencyStatistics
+{
+  public:
+    /// @brief Constructor
+    LatencyStatistics();
+
+    /// @brief Adds latency sample (ms)
+    void Add(const double latency_ms);
+
+    /// @brief Provides number of samples
+    std::size_t GetCount() const;
+
+    /// @brief Provides minimum latency (ms), 0 if no samples
+    double GetMin() const;
+
+    /// @brief Provides mean latency (ms), 0 if no samples
+    double GetMean() const;
+
+    /// @brief Provides maximum latency (ms), 0 if no samples
+    double GetMax() const;
+
+    /// @brief Provides percentile latency (ms) using nearest-rank method, 0 if no samples
+    /// @param [in] percentile - Percentile (0, 100]
+    double GetPercentile(const double percentile) const;
+
+    /// @brief Provides histogram of samples, with equally wide buckets between min and max latency
+    /// @param [in] number_of_buckets - Number of Buckets
+    /// @return Number of samples, per bucket
+    std::vector<std::size_t> GetHistogram(const std::size_t number_of_buckets) const;
+
+    /// @brief Provides summary as JSON object, i.e.
+    ///        {"count": n, "min_ms": .., "mean_ms": .., "p50_ms": .., "p90_ms": .., "p99_ms": .., "max_ms": ..,
+    ///         "histogram": {"bucket_width_ms": .., "counts": [..]}}
+    /// @param [in] number_of_buckets - Number of Histogram Buckets
+    std::string ToJson(const std::size_t number_of_buckets) const;
+
+  private:
+    /// @brief Latency samples (ms)
+    std::vector<double> samples_;
+};
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_LATENCY_STATISTICS_H_
@@ -0,0 +1,54 @@
+///
+/// @file mapped_file.h
+/// @brief Contains Read-Only Memory Mapped File
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_MAPPED_FILE_H_
+#define PERCEPTION_UTILS_MAPPED_FILE_H_
+
+#include <cstdint>
+#include <string>
+
+namespace perception
+{
+/// @brief Read-only memory mapping of a whole file (i.e. file contents without copying them to the heap)
+class MappedFile
+{
+  public:
+    /// @brief Constructor
+    /// @param [in] path - File Path
+    /// @throws std::runtime_error if file could not be opened or mapped
+    explicit MappedFile(const std::string& path);
+
+    /// @brief Move Constructor
+    MappedFile(MappedFile&& other) noexcept;
+
+    /// @brief Move Assignment
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// @brief Destructor (unmaps file)
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// @brief Provides file contents (valid until destruction)
+    const std::uint8_t* GetData() const;
+
+    /// @brief Provides file size (bytes)
+    std::size_t GetSize() const;
+
+  private:
+    /// @brief Unmaps file, if mapped
+    void Reset();
+
+    /// @brief Mapped file contents
+    std::uint8_t* data_;
+
+    /// @brief Mapped file size (bytes)
+    std::size_t size_;
+};
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_MAPPED_FILE_H_
@@ -0,0 +1,152 @@
+///
+/// @file resize_bilinear.h
+/// @brief Contains native Bilinear Resize (+ Normalization) kernel
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_RESIZE_BILINEAR_H_
+#define PERCEPTION_UTILS_RESIZE_BILINEAR_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "perception/utils/cpu_features.h"
+
+namespace perception
+{
+/// @brief Bilinear Resize kernel (align_corners = false), equivalent to TFLite RESIZE_BILINEAR.
+///
+/// Sampling positions and weights are precomputed once per (source shape, target shape). Each call then does
+/// resize, channel handling and normalization in a single pass, writing straight into the provided output
+/// (i.e. model input tensor). Source rows are blended vertically with SIMD (SSE4.1/AVX2, scalar fallback).
+///
+/// Integer outputs (uint8/int8) never leave integer arithmetic: weights are Q11 fixed-point, source rows are
+/// blended with SSE2/AVX2 multiply-add and each resized pixel is mapped to the quantized domain through a
+/// 256 entry lookup table (see CreateQuantizationTable()).
+///
+/// Channel handling: equal channels are copied, 1 channel is broadcast, extra channels (i.e. alpha) are dropped,
+/// and 3/4 channels to 1 channel is converted to luma (BT.601).
+///
+/// @note Tolerance against TFLite RESIZE_BILINEAR (see resize_bilinear_benchmark): float outputs match within
+///       1e-5 (absolute, after normalization), integer outputs within +/-1 (fixed-point rounds to nearest, where
+///       TFLite path truncated).
+class BilinearResizer
+{
+  public:
+    /// @brief Constructor
+    /// @param [in] input_height - Source Height
+    /// @param [in] input_width - Source Width
+    /// @param [in] input_channels - Source Channels
+    /// @param [in] output_height - Wanted Height
+    /// @param [in] output_width - Wanted Width
+    /// @param [in] output_channels - Wanted Channels
+    /// @param [in] instruction_set - Instruction set to be used (defaults to best supported)
+    BilinearResizer(const std::int32_t input_height, const std::int32_t input_width, const std::int32_t input_channels,
+                    const std::int32_t output_height, const std::int32_t output_width,
+                    const std::int32_t output_channels,
+                    const InstructionSet instruction_set = GetSupportedInstructionSet());
+
+    /// @brief Resize and Normalize, i.e. output = resized * scale + offset
+    /// @param [in] input - Source Image (HWC)
+    /// @param [in] scale - Normalization scale (i.e. 1 / input_std)
+    /// @param [in] offset - Normalization offset (i.e. -input_mean / input_std)
+    /// @param [out] output - Output buffer of output_height * output_width * output_channels
+    void Resize(const std::uint8_t* input, const float scale, const float offset, float* output);
+
+    /// @brief Resize (no normalization)
+    /// @param [in] input - Source Image (HWC)
+    /// @param [out] output - Output buffer of output_height * output_width * output_channels
+    void Resize(const std::uint8_t* input, std::uint8_t* output);
+
+    /// @brief Resize and Quantize (integer only), i.e. output = table[resized]
+    /// @param [in] input - Source Image (HWC)
+    /// @param [in] table - Quantization table of 256 entries (see CreateQuantizationTable())
+    /// @param [out] output - Output buffer of output_height * output_width * output_channels
+    void Resize(const std::uint8_t* input, const std::uint8_t* table, std::uint8_t* output);
+
+    /// @brief Resize and Quantize (integer only), i.e. output = table[resized]
+    /// @param [in] input - Source Image (HWC)
+    /// @param [in] table - Quantization table of 256 entries (see CreateQuantizationTable())
+    /// @param [out] output - Output buffer of output_height * output_width * output_channels
+    void Resize(const std::uint8_t* input, const std::int8_t* table, std::int8_t* output);
+
+  private:
+    /// @brief Signature of vertical (row) interpolation kernels
+    using InterpolateRowsFunction = void (*)(const std::uint8_t* top, const std::uint8_t* bottom,
+                                             const std::int32_t size, const float dy, const float scale,
+                                             const float offset, float* output);
+
+    /// @brief Signature of fixed-point vertical (row) interpolation kernels
+    using InterpolateRowsFixedFunction = void (*)(const std::uint8_t* top, const std::uint8_t* bottom,
+                                                  const std::int32_t size, const std::int32_t dy,
+                                                  std::int32_t* output);
+
+    /// @brief Horizontal interpolation (and channel handling) of the current blended row
+    void InterpolateColumns(float* output) const;
+
+    /// @brief Resize into output of integer type T, through the quantization table
+    template <typename T>
+    void ResizeFixed(const std::uint8_t* input, const T* table, T* output);
+
+    /// @brief Fixed-point horizontal interpolation (and channel handling) of the current blended row
+    template <typename T>
+    void InterpolateColumnsFixed(const T* table, T* output) const;
+
+    /// @brief Source Dimensions
+    std::int32_t input_width_;
+    std::int32_t input_channels_;
+
+    /// @brief Wanted Dimensions
+    std::int32_t output_height_;
+    std::int32_t output_width_;
+    std::int32_t output_channels_;
+
+    /// @brief Top/Bottom source row and weight (float and Q11 fixed-point), per output row
+    std::vector<std::int32_t> y0_;
+    std::vector<std::int32_t> y1_;
+    std::vector<float> dy_;
+    std::vector<std::int32_t> fixed_dy_;
+
+    /// @brief Left/Right source element offset and weight (float and Q11 fixed-point), per output column
+    std::vector<std::int32_t> x0_;
+    std::vector<std::int32_t> x1_;
+    std::vector<float> dx_;
+    std::vector<std::int32_t> fixed_dx_;
+
+    /// @brief Source channel, per output channel
+    std::vector<std::int32_t> channel_map_;
+
+    /// @brief Convert source channels to luma?
+    bool luma_;
+
+    /// @brief Vertically blended (and normalized) source row
+    std::vector<float> row_;
+
+    /// @brief Vertically blended source row (Q11 fixed-point)
+    std::vector<std::int32_t> fixed_row_;
+
+    /// @brief Identity quantization table (i.e. plain uint8 resize)
+    std::vector<std::uint8_t> identity_table_;
+
+    /// @brief Selected row interpolation kernels
+    InterpolateRowsFunction interpolate_rows_;
+    InterpolateRowsFixedFunction interpolate_rows_fixed_;
+};
+
+/// @brief Creates table mapping pixel value [0, 255] to quantized model input, i.e.
+///        q = clamp(round(((pixel - input_mean) / input_std) / scale) + zero_point)
+/// @note  If scale is 0 (i.e. unquantized tensor), pixel value is passed as is (shifted by -128 for int8).
+/// @param [in] input_mean - Input Mean
+/// @param [in] input_std - Input StdDev
+/// @param [in] scale - Quantization scale of the model input
+/// @param [in] zero_point - Quantization zero point of the model input
+/// @param [out] table - 256 entries
+void CreateQuantizationTable(const float input_mean, const float input_std, const float scale,
+                             const std::int32_t zero_point, std::uint8_t* table);
+
+/// @copydoc CreateQuantizationTable()
+void CreateQuantizationTable(const float input_mean, const float input_std, const float scale,
+                             const std::int32_t zero_point, std::int8_t* table);
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_RESIZE_BILINEAR_H_
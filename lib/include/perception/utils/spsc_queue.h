@@ -0,0 +1,222 @@
+///
+/// @file spsc_queue.h
+/// @brief Contains bounded Single Producer Single Consumer (SPSC) ring buffer
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_SPSC_QUEUE_H_
+#define PERCEPTION_UTILS_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace perception
+{
+/// @brief Bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+///
+/// Push() blocks while the queue is full, which provides backpressure to the producer. Producer calls Close() once
+/// done; consumer then drains remaining elements and Pop() returns false.
+///
+/// Push and pop stay lock-free. Only a thread which finds the queue full (resp. empty) takes the mutex and sleeps on a
+/// condition variable; the other side checks a waiting flag after each push (resp. pop) and only then notifies, i.e.
+/// idle stages do not burn a core.
+template <typename T>
+class SpscQueue
+{
+  public:
+    /// @brief Constructor
+    /// @param [in] capacity - Maximum number of queued elements
+    explicit SpscQueue(const std::size_t capacity)
+        : buffer_(capacity + 1U),
+          head_{0U},
+          tail_{0U},
+          closed_{false},
+          mutex_{},
+          space_available_{},
+          element_available_{},
+          producer_waiting_{false},
+          consumer_waiting_{false}
+    {
+    }
+
+    /// @brief Push element, if there is space (producer only)
+    /// @return true if pushed (value is moved from), false if queue is full
+    bool TryPush(T&& value)
+    {
+        if (!Enqueue(std::move(value)))
+        {
+            return false;
+        }
+        WakeUp(consumer_waiting_, &element_available_);
+        return true;
+    }
+
+    /// @brief Push element, waits while queue is full (producer only)
+    /// @return false if queue got closed before element could be pushed
+    bool Push(T value)
+    {
+        if (TryPush(std::move(value)))
+        {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock{mutex_};
+        // flag and indices are sequentially consistent, i.e. either the pop is seen below or the flag is seen by the
+        // consumer (see WakeUp())
+        producer_waiting_.store(true, std::memory_order_seq_cst);
+        auto pushed = false;
+        while (!IsClosed())
+        {
+            if ((pushed = Enqueue(std::move(value))))
+            {
+                break;
+            }
+            space_available_.wait(lock);
+        }
+        producer_waiting_.store(false, std::memory_order_relaxed);
+        lock.unlock();
+        if (pushed)
+        {
+            WakeUp(consumer_waiting_, &element_available_);
+        }
+        return pushed;
+    }
+
+    /// @brief Pop element, if available (consumer only)
+    /// @return true if popped, false if queue is empty
+    bool TryPop(T* value)
+    {
+        if (!Dequeue(value))
+        {
+            return false;
+        }
+        WakeUp(producer_waiting_, &space_available_);
+        return true;
+    }
+
+    /// @brief Pop element, waits while queue is empty (consumer only)
+    /// @return false once queue is closed and drained
+    bool Pop(T* value)
+    {
+        if (TryPop(value))
+        {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock{mutex_};
+        consumer_waiting_.store(true, std::memory_order_seq_cst);
+        auto popped = false;
+        while (true)
+        {
+            // closed is read before the (last) pop, as producer may have pushed right before closing
+            const auto closed = IsClosed();
+            if ((popped = Dequeue(value)) || closed)
+            {
+                break;
+            }
+            element_available_.wait(lock);
+        }
+        consumer_waiting_.store(false, std::memory_order_relaxed);
+        lock.unlock();
+        if (popped)
+        {
+            WakeUp(producer_waiting_, &space_available_);
+        }
+        return popped;
+    }
+
+    /// @brief Marks end of stream (i.e. no more elements will be pushed) and wakes up waiting producer/consumer
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            closed_.store(true, std::memory_order_release);
+        }
+        space_available_.notify_one();
+        element_available_.notify_one();
+    }
+
+    /// @brief Is end of stream marked?
+    bool IsClosed() const { return closed_.load(std::memory_order_acquire); }
+
+    /// @brief Provides number of queued elements (approximate, while producer/consumer are running)
+    std::size_t GetSize() const
+    {
+        const auto head = head_.load(std::memory_order_acquire);
+        const auto tail = tail_.load(std::memory_order_acquire);
+        return (tail >= head) ? (tail - head) : (tail + buffer_.size() - head);
+    }
+
+    /// @brief Provides maximum number of queued elements
+    std::size_t GetCapacity() const { return buffer_.size() - 1U; }
+
+  private:
+    /// @brief Next slot index (wraps around)
+    std::size_t Increment(const std::size_t index) const { return (index + 1U == buffer_.size()) ? 0U : index + 1U; }
+
+    /// @brief Push element, if there is space (without waking up the consumer)
+    bool Enqueue(T&& value)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        const auto next = Increment(tail);
+        if (next == head_.load(std::memory_order_seq_cst))
+        {
+            return false;
+        }
+        buffer_[tail] = std::move(value);
+        tail_.store(next, std::memory_order_seq_cst);
+        return true;
+    }
+
+    /// @brief Pop element, if available (without waking up the producer)
+    bool Dequeue(T* value)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_seq_cst))
+        {
+            return false;
+        }
+        *value = std::move(buffer_[head]);
+        head_.store(Increment(head), std::memory_order_seq_cst);
+        return true;
+    }
+
+    /// @brief Notifies the other side, if it waits (lock is taken only then, must not be held by caller)
+    void WakeUp(const std::atomic<bool>& waiting, std::condition_variable* condition)
+    {
+        // sequentially consistent after the push (resp. pop), see Push()/Pop()
+        if (waiting.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            condition->notify_one();
+        }
+    }
+
+    /// @brief Ring buffer (one slot is always kept free to distinguish full from empty)
+    std::vector<T> buffer_;
+
+    /// @brief Next slot to pop (written by consumer only)
+    std::atomic<std::size_t> head_;
+
+    /// @brief Next slot to push (written by producer only)
+    std::atomic<std::size_t> tail_;
+
+    /// @brief End of stream?
+    std::atomic<bool> closed_;
+
+    /// @brief Guards sleeping of producer resp. consumer (slow path only)
+    std::mutex mutex_;
+
+    /// @brief Notified on pop resp. push (and Close()), if the other side waits
+    std::condition_variable space_available_;
+    std::condition_variable element_available_;
+
+    /// @brief Producer waits for space resp. consumer waits for element
+    std::atomic<bool> producer_waiting_;
+    std::atomic<bool> consumer_waiting_;
+};
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_SPSC_QUEUE_H_
@@ -0,0 +1,84 @@
+///
+/// @file thread_pool.h
+/// @brief Contains fixed size Thread Pool for fork-join (parallel for) work
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_THREAD_POOL_H_
+#define PERCEPTION_UTILS_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace perception
+{
+/// @brief Fixed size Thread Pool. Worker threads are started once and sleep between ParallelFor() calls, so that
+///        short parallel sections (i.e. single image decode) do not pay for thread creation.
+class ThreadPool
+{
+  public:
+    /// @brief Task, called with task index [0, count)
+    using Task = std::function<void(const std::size_t index)>;
+
+    /// @brief Constructor
+    /// @param [in] number_of_threads - Concurrency, incl. the thread calling ParallelFor() (i.e. 1 starts no workers)
+    explicit ThreadPool(const std::size_t number_of_threads);
+
+    /// @brief Destructor (joins worker threads)
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Provides concurrency, incl. the calling thread
+    std::size_t GetSize() const;
+
+    /// @brief Runs task for each index [0, count) on the workers and the calling thread, returns once all are done.
+    ///        Concurrent callers are serialized.
+    /// @throws first exception thrown by any of the tasks (remaining tasks still run)
+    void ParallelFor(const std::size_t count, const Task& task);
+
+  private:
+    /// @brief Worker thread loop
+    void Work();
+
+    /// @brief Runs unclaimed tasks of current ParallelFor() until there are none left
+    void RunTasks(const Task& task, const std::size_t count);
+
+    /// @brief Worker Threads
+    std::vector<std::thread> workers_;
+
+    /// @brief Serializes ParallelFor() callers
+    std::mutex call_mutex_;
+
+    /// @brief Guards the current job (below) and worker wake ups
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable work_done_;
+
+    /// @brief Current job, nullptr once ParallelFor() returned
+    const Task* task_;
+    std::size_t count_;
+    std::uint64_t generation_;
+
+    /// @brief Number of workers running tasks of current job
+    std::size_t active_workers_;
+
+    /// @brief Next unclaimed task index of current job
+    std::atomic<std::size_t> next_index_;
+
+    /// @brief First failure of current job
+    std::exception_ptr error_;
+
+    /// @brief Set on destruction
+    bool stopping_;
+};
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_THREAD_POOL_H_
@@ -0,0 +1,55 @@
+///
+/// @file top_k.h
+/// @brief Contains Top K selection over classification outputs (float, uint8 and int8)
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef PERCEPTION_UTILS_TOP_K_H_
+#define PERCEPTION_UTILS_TOP_K_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "perception/utils/cpu_features.h"
+
+namespace perception
+{
+/// @brief Top K results, i.e. pairs of (confidence, index) sorted by confidence in descending order (equal
+///        confidences by index in descending order, same as get_top_n)
+using TopKResults = std::vector<std::pair<float, std::int32_t>>;
+
+/// @brief Provides Top K scores not below threshold.
+///
+/// Scores are compared within their own domain: the threshold of quantized scores is converted once to the smallest
+/// passing quantized value. SIMD kernels (SSE2: 16 resp. 4 scores, AVX2: 32 resp. 8 scores per compare) skip blocks
+/// without any score reaching the current bound, i.e. max(threshold, K-th candidate), only the remaining ones are
+/// inserted into a sorted array of K candidates. Results are the same for all instruction sets.
+///
+/// @param [in] scores - Scores (i.e. Model Output of single batch slot)
+/// @param [in] size - Number of scores
+/// @param [in] k - Number of results (K)
+/// @param [in] threshold - Minimum confidence
+/// @param [in] instruction_set - Instruction set to be used (defaults to best supported)
+/// @return results - at most K results, confidence not below threshold
+TopKResults GetTopK(const float* scores, const std::int32_t size, const std::size_t k, const float threshold,
+                    const InstructionSet instruction_set = GetSupportedInstructionSet());
+
+/// @brief Provides Top K of quantized scores not below threshold, see GetTopK() for float scores.
+/// @param [in] scale - Quantization scale, i.e. confidence = (score - zero_point) * scale. Scores without quantization
+///                     parameters (scale 0) are confidence = score / 255.
+/// @param [in] zero_point - Quantization zero point
+TopKResults GetTopK(const std::uint8_t* scores, const std::int32_t size, const std::size_t k, const float threshold,
+                    const float scale, const std::int32_t zero_point,
+                    const InstructionSet instruction_set = GetSupportedInstructionSet());
+
+/// @brief Provides Top K of quantized scores not below threshold, see GetTopK() for float scores.
+/// @param [in] scale - Quantization scale, i.e. confidence = (score - zero_point) * scale
+/// @param [in] zero_point - Quantization zero point
+TopKResults GetTopK(const std::int8_t* scores, const std::int32_t size, const std::size_t k, const float threshold,
+                    const float scale, const std::int32_t zero_point,
+                    const InstructionSet instruction_set = GetSupportedInstructionSet());
+
+}  // namespace perception
+
+#endif  // PERCEPTION_UTILS_TOP_K_H_
@@ -2,6 +2,7 @@
 /// @file argument_parser.cpp
 /// @copyright Copyright (c) 2020. All Rights Reserved.
 ///
+#include <cstdio>
 #include <iostream>
 
 #include "perception/argument_parser/argument_parser.h"
@@ -27,6 +28,16 @@ void PrintUsage()
               << "--threads, -t: number of threads\n"
               << "--verbose, -v: [0|1] print more information\n"
               << "--save_results, -f: [0:1] save results in result_directory\n"
+              << "--benchmark, -k: [0|1] benchmark mode, writes latency statistics to result_directory\n"
+              << "--warmup_runs, -w: number of warmup runs in benchmark mode\n"
+              << "--pipeline, -x: [0|1] pipeline mode, overlaps decode/preprocess with invoke of loop_count frames\n"
+              << "--delegate, -g: delegate name [none|nnapi|<registered custom delegate>]\n"
+              << "--decode_threads, -j: number of threads for JPEG decode\n"
+              << "--roi, -o: x,y,width,height region of interest within image\n"
+              << "--input_cache, -q: input cache size in MB for repeated images [0 to disable]\n"
+              << "--batch, -a: directory or manifest file of images to classify in batch mode\n"
+              << "--batch_workers, -n: number of workers in batch mode\n"
+              << "--batch_output, -u: batch mode results file in result_directory [.jsonl|.csv]\n"
               << "--help, -h: print help\n";
 }
 }  // namespace
@@ -46,9 +57,19 @@ ArgumentParser::ArgumentParser(int argc, char* argv[])
                     {"verbose", required_argument, nullptr, 'v'},
                     {"result_directory", required_argument, nullptr, 'd'},
                     {"save_results", required_argument, nullptr, 'f'},
+                    {"benchmark", required_argument, nullptr, 'k'},
+                    {"warmup_runs", required_argument, nullptr, 'w'},
+                    {"pipeline", required_argument, nullptr, 'x'},
+                    {"delegate", required_argument, nullptr, 'g'},
+                    {"decode_threads", required_argument, nullptr, 'j'},
+                    {"roi", required_argument, nullptr, 'o'},
+                    {"input_cache", required_argument, nullptr, 'q'},
+                    {"batch", required_argument, nullptr, 'a'},
+                    {"batch_workers", required_argument, nullptr, 'n'},
+                    {"batch_output", required_argument, nullptr, 'u'},
                     {"help", 0, nullptr, 'h'},
                     {nullptr, 0, nullptr, 0}},
-      optstring_{"b:c:d:e:f:h:i:l:m:p:r:s:v:t:"}
+      optstring_{"a:b:c:d:e:f:g:h:i:j:k:l:m:n:o:p:q:r:s:u:v:t:w:x:"}
 {
     cli_options_ = ParseArgs(argc, argv);
 }
@@ -73,6 +94,10 @@ CLIOptions ArgumentParser::ParseArgs(int argc, char* argv[])
 
         switch (c)
         {
+            case 'a':
+                cli_options_.batch_input = optarg;
+                LOG(INFO) << "batch_input: " << cli_options_.batch_input;
+                break;
             case 'b':
                 cli_options_.input_mean = strtod(optarg, nullptr);
                 LOG(INFO) << "input_mean: " << cli_options_.input_mean;
@@ -93,10 +118,22 @@ CLIOptions ArgumentParser::ParseArgs(int argc, char* argv[])
                 cli_options_.save_results = strtol(optarg, nullptr, 10);
                 LOG(INFO) << "save_results: " << cli_options_.save_results;
                 break;
+            case 'g':
+                cli_options_.delegate = optarg;
+                LOG(INFO) << "delegate: " << cli_options_.delegate;
+                break;
             case 'i':
                 cli_options_.input_name = optarg;
                 LOG(INFO) << "input_name: " << cli_options_.input_name;
                 break;
+            case 'j':
+                cli_options_.decode_threads = strtol(optarg, nullptr, 10);
+                LOG(INFO) << "decode_threads: " << cli_options_.decode_threads;
+                break;
+            case 'k':
+                cli_options_.benchmark = strtol(optarg, nullptr, 10);
+                LOG(INFO) << "benchmark: " << cli_options_.benchmark;
+                break;
             case 'l':
                 cli_options_.labels_name = optarg;
                 LOG(INFO) << "labels_name: " << cli_options_.labels_name;
@@ -105,10 +142,28 @@ CLIOptions ArgumentParser::ParseArgs(int argc, char* argv[])
                 cli_options_.model_name = optarg;
                 LOG(INFO) << "model_name: " << cli_options_.model_name;
                 break;
+            case 'n':
+                cli_options_.batch_workers = strtol(optarg, nullptr, 10);
+                LOG(INFO) << "batch_workers: " << cli_options_.batch_workers;
+                break;
+            case 'o':
+                if (std::sscanf(optarg, "%d,%d,%d,%d", &cli_options_.roi_x, &cli_options_.roi_y,
+                                &cli_options_.roi_width, &cli_options_.roi_height) != 4)
+                {
+                    PrintUsage();
+                    exit(1);
+                }
+                LOG(INFO) << "roi: " << cli_options_.roi_x << "," << cli_options_.roi_y << ","
+                          << cli_options_.roi_width << "," << cli_options_.roi_height;
+                break;
             case 'p':
                 cli_options_.profiling = strtol(optarg, nullptr, 10);
                 LOG(INFO) << "profiling: " << cli_options_.profiling;
                 break;
+            case 'q':
+                cli_options_.input_cache_mb = strtol(optarg, nullptr, 10);
+                LOG(INFO) << "input_cache_mb: " << cli_options_.input_cache_mb;
+                break;
             case 'r':
                 cli_options_.number_of_results = strtol(optarg, nullptr, 10);
                 LOG(INFO) << "number_of_results: " << cli_options_.number_of_results;
@@ -121,10 +176,22 @@ CLIOptions ArgumentParser::ParseArgs(int argc, char* argv[])
                 cli_options_.number_of_threads = strtol(optarg, nullptr, 10);
                 LOG(INFO) << "number_of_threads: " << cli_options_.number_of_threads;
                 break;
+            case 'u':
+                cli_options_.batch_output = optarg;
+                LOG(INFO) << "batch_output: " << cli_options_.batch_output;
+                break;
             case 'v':
                 cli_options_.verbose = strtol(optarg, nullptr, 10);
                 LOG(INFO) << "verbose: " << cli_options_.verbose;
                 break;
+            case 'w':
+                cli_options_.warmup_runs = strtol(optarg, nullptr, 10);
+                LOG(INFO) << "warmup_runs: " << cli_options_.warmup_runs;
+                break;
+            case 'x':
+                cli_options_.pipeline = strtol(optarg, nullptr, 10);
+                LOG(INFO) << "pipeline: " << cli_options_.pipeline;
+                break;
             case 'h':
             case '?':
                 /* getopt_long already printed an error message. */
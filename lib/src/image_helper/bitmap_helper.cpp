@@ -13,106 +13,238 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 
 #include "perception/image_helper/bitmap_helper.h"
 #include "perception/logging/logging.h"
 
 namespace perception
 {
-BitmapImageHelper::BitmapImageHelper() : width_{224}, height_{224}, channels_{3} {}
+namespace
+{
+/// @brief Is given bits per pixel supported, i.e. 1 (grayscale), 3 (BGR) or 4 (BGRA) channels of 8 bit?
+bool IsSupportedBitsPerPixel(const std::int32_t bpp) { return (bpp == 8) || (bpp == 24) || (bpp == 32); }
+
+/// @brief Is given height valid, i.e. its magnitude (number of rows) representable?
+bool IsValidHeight(const std::int32_t height) { return height != std::numeric_limits<std::int32_t>::min(); }
+}  // namespace
+
+BitmapImageHelper::BitmapImageHelper()
+    : width_{224},
+      height_{224},
+      channels_{3},
+      roi_x_{0},
+      roi_y_{0},
+      roi_width_{0},
+      roi_height_{0},
+      region_x_{0},
+      region_y_{0},
+      region_width_{224},
+      region_height_{224},
+      row_size_{0U},
+      kernels_{GetBitmapKernels()},
+      image_{}
+{
+}
 BitmapImageHelper::~BitmapImageHelper() {}
 
 std::vector<std::uint8_t> BitmapImageHelper::ReadImage(const std::string& image_path, std::int32_t* width,
                                                        std::int32_t* height, std::int32_t* channels)
+{
+    const MappedFile bmp_file{image_path};
+    const auto bmp_pixels = ReadHeader(bmp_file, image_path);
+    GetRegionDimensions(width, height, channels);
+    return DecodeImage(bmp_pixels);
+}
+
+void BitmapImageHelper::ReadImage(const std::string& image_path, std::uint8_t* output, const std::size_t output_size,
+                                  std::int32_t* width, std::int32_t* height, std::int32_t* channels)
+{
+    const MappedFile bmp_file{image_path};
+    const auto bmp_pixels = ReadHeader(bmp_file, image_path);
+    // dimensions are only provided along with the image, i.e. not for a rejected output buffer
+    if (!output || (output_size < GetImageSize()))
+    {
+        throw std::runtime_error("Output buffer of " + std::to_string(output_size) + " bytes is too small for " +
+                                 image_path + " (" + std::to_string(GetImageSize()) + " bytes)");
+    }
+    GetRegionDimensions(width, height, channels);
+    DecodeImage(bmp_pixels, output);
+}
+
+ImageInfo BitmapImageHelper::Probe(const std::string& image_path) const
 {
     std::ifstream file(image_path, std::ios::in | std::ios::binary);
     if (!file)
     {
         throw std::runtime_error("Input file " + image_path + " not found");
     }
-    auto begin = file.tellg();
-    file.seekg(0, std::ios::end);
-    auto end = file.tellg();
-    const auto len = (end - begin);
-
-    std::vector<std::uint8_t> img_bytes(len);
-    file.seekg(0, std::ios::beg);
-    file.read(reinterpret_cast<char*>(img_bytes.data()), len);
-
-    const std::int32_t header_size = *(reinterpret_cast<const std::int32_t*>(img_bytes.data() + 10));
-    width_ = *(reinterpret_cast<const std::int32_t*>(img_bytes.data() + 18));
-    height_ = *(reinterpret_cast<const std::int32_t*>(img_bytes.data() + 22));
-    const std::int32_t bpp = *(reinterpret_cast<const std::int32_t*>(img_bytes.data() + 28));
+
+    // file header (14 bytes) and the part of info header read by ReadImage()
+    std::array<std::uint8_t, 30> header{};
+    if (!file.read(reinterpret_cast<char*>(header.data()), header.size()) || (header[0] != 'B') || (header[1] != 'M'))
+    {
+        throw std::runtime_error("Input file " + image_path + " is not a BMP file");
+    }
+
+    ImageInfo info{};
+    info.format = ImageFormat::kBitmap;
+    info.width = *(reinterpret_cast<const std::int32_t*>(header.data() + 18));
+    const std::int32_t height = *(reinterpret_cast<const std::int32_t*>(header.data() + 22));
+    if ((info.width <= 0) || !IsValidHeight(height))
+    {
+        throw std::runtime_error("Input file " + image_path + " has invalid dimensions");
+    }
+    info.height = std::abs(height);
+    const std::int32_t bpp = *(reinterpret_cast<const std::uint16_t*>(header.data() + 28));
+    if (!IsSupportedBitsPerPixel(bpp))
+    {
+        throw std::runtime_error("Unexpected number of bits per pixel: " + std::to_string(bpp));
+    }
+    info.channels = bpp / 8;
+    info.horizontal_subsampling = 1;
+    info.vertical_subsampling = 1;
+    return info;
+}
+
+const std::uint8_t* BitmapImageHelper::ReadImageView(const std::string& image_path, std::int32_t* width,
+                                                     std::int32_t* height, std::int32_t* channels)
+{
+    // image buffer is reused, i.e. only reallocated when the image grows
+    const MappedFile bmp_file{image_path};
+    const auto bmp_pixels = ReadHeader(bmp_file, image_path);
+    GetRegionDimensions(width, height, channels);
+    image_.resize(GetImageSize());
+    DecodeImage(bmp_pixels, image_.data());
+    return image_.data();
+}
+
+void BitmapImageHelper::SetMinimumSize(const std::int32_t /* width */, const std::int32_t /* height */) {}
+
+void BitmapImageHelper::SetNumberOfThreads(const std::int32_t /* number_of_threads */) {}
+
+void BitmapImageHelper::SetRegionOfInterest(const std::int32_t x, const std::int32_t y, const std::int32_t width,
+                                            const std::int32_t height)
+{
+    roi_x_ = x;
+    roi_y_ = y;
+    roi_width_ = width;
+    roi_height_ = height;
+}
+
+void BitmapImageHelper::SetLumaOnly(const bool /* luma_only */) {}
+
+const std::uint8_t* BitmapImageHelper::ReadHeader(const MappedFile& bmp_file, const std::string& image_path)
+{
+    // file header (14 bytes) and the part of info header read here
+    const std::uint8_t* bmp_bytes = bmp_file.GetData();
+    if ((bmp_file.GetSize() < 30U) || (bmp_bytes[0] != 'B') || (bmp_bytes[1] != 'M'))
+    {
+        throw std::runtime_error("Input file " + image_path + " is not a BMP file");
+    }
+    const std::int32_t header_size = *(reinterpret_cast<const std::int32_t*>(bmp_bytes + 10));
+    width_ = *(reinterpret_cast<const std::int32_t*>(bmp_bytes + 18));
+    height_ = *(reinterpret_cast<const std::int32_t*>(bmp_bytes + 22));
+    const std::int32_t bpp = *(reinterpret_cast<const std::uint16_t*>(bmp_bytes + 28));
+    if (!IsSupportedBitsPerPixel(bpp))
+    {
+        throw std::runtime_error("Unexpected number of bits per pixel: " + std::to_string(bpp));
+    }
     channels_ = bpp / 8;
 
+    if ((width_ <= 0) || !IsValidHeight(height_))
+    {
+        throw std::runtime_error("Input file " + image_path + " has invalid dimensions");
+    }
+
+    // rows are padded to a multiple of 4 bytes, pixels are read in place and thus must be within the file. Row size
+    // (below 2^35) is computed in 64 bit and the rows are checked by division, thus neither of them can wrap around.
+    const std::uint64_t row_size = (static_cast<std::uint64_t>(bpp) * width_ + 31U) / 32U * 4U;
+    const std::uint64_t rows = static_cast<std::uint64_t>(std::abs(height_));
+    if ((header_size < 0) || (static_cast<std::uint64_t>(header_size) > bmp_file.GetSize()) ||
+        ((rows > 0U) && (row_size > (bmp_file.GetSize() - static_cast<std::uint64_t>(header_size)) / rows)))
+    {
+        throw std::runtime_error("Input file " + image_path + " is truncated");
+    }
+    row_size_ = static_cast<std::size_t>(row_size);
+
+    region_x_ = 0;
+    region_y_ = 0;
+    region_width_ = width_;
+    region_height_ = std::abs(height_);
+    if ((roi_width_ > 0) && (roi_height_ > 0))
+    {
+        region_x_ = std::max(roi_x_, 0);
+        region_y_ = std::max(roi_y_, 0);
+        region_width_ = static_cast<std::int32_t>(
+            std::min<std::int64_t>(static_cast<std::int64_t>(roi_x_) + roi_width_, width_) - region_x_);
+        region_height_ = static_cast<std::int32_t>(
+            std::min<std::int64_t>(static_cast<std::int64_t>(roi_y_) + roi_height_, std::abs(height_)) - region_y_);
+        if ((region_width_ <= 0) || (region_height_ <= 0))
+        {
+            throw std::runtime_error("Region of interest is outside of " + image_path);
+        }
+    }
+
+    return &bmp_bytes[header_size];
+}
+
+void BitmapImageHelper::GetRegionDimensions(std::int32_t* width, std::int32_t* height, std::int32_t* channels) const
+{
     if (!width || !height || !channels)
     {
         throw std::runtime_error("Received nullptr for width/height/channels.");
     }
-    *width = width_;
-    *height = height_;
+    *width = region_width_;
+    *height = region_height_;
     *channels = channels_;
+}
 
-    // Decode image, allocating tensor once the image size is known
-    const uint8_t* bmp_pixels = &img_bytes[header_size];
-    return DecodeImage(bmp_pixels);
+std::size_t BitmapImageHelper::GetImageSize() const
+{
+    return static_cast<std::size_t>(region_width_) * region_height_ * channels_;
 }
 
 std::vector<std::uint8_t> BitmapImageHelper::DecodeImage(const std::uint8_t* input) const
 {
-    // there may be padding bytes when the width is not a multiple of 4 bytes
-    // 8 * channels == bits per pixel
-    const std::int32_t row_size = (8 * channels_ * width_ + 31) / 32 * 4;
+    std::vector<std::uint8_t> output(GetImageSize());
+    DecodeImage(input, output.data());
+    return output;
+}
 
+void BitmapImageHelper::DecodeImage(const std::uint8_t* input, std::uint8_t* output) const
+{
     // if height is negative, data layout is top down
     // otherwise, it's bottom up
     const bool top_down = (height_ < 0);
 
-    std::vector<uint8_t> output(abs(height_) * width_ * channels_);
-    for (int i = 0; i < abs(height_); i++)
+    // only region of interest is copied (whole image by default), one row at a time
+    const std::size_t output_row_size = static_cast<std::size_t>(region_width_) * channels_;
+    for (std::int32_t i = 0; i < region_height_; ++i)
     {
-        int src_pos;
-        int dst_pos;
-
-        for (int j = 0; j < width_; j++)
+        const std::int32_t row = top_down ? (region_y_ + i) : (std::abs(height_) - 1 - region_y_ - i);
+        const std::uint8_t* src = &input[static_cast<std::size_t>(row) * row_size_ + region_x_ * channels_];
+        std::uint8_t* dst = &output[static_cast<std::size_t>(i) * output_row_size];
+        switch (channels_)
         {
-            if (!top_down)
-            {
-                src_pos = ((abs(height_) - 1 - i) * row_size) + j * channels_;
-            }
-            else
-            {
-                src_pos = i * row_size + j * channels_;
-            }
-
-            dst_pos = (i * width_ + j) * channels_;
-
-            switch (channels_)
-            {
-                case 1:
-                    output[dst_pos] = input[src_pos];
-                    break;
-                case 3:
-                    // BGR -> RGB
-                    output[dst_pos] = input[src_pos + 2];
-                    output[dst_pos + 1] = input[src_pos + 1];
-                    output[dst_pos + 2] = input[src_pos];
-                    break;
-                case 4:
-                    // BGRA -> RGBA
-                    output[dst_pos] = input[src_pos + 2];
-                    output[dst_pos + 1] = input[src_pos + 1];
-                    output[dst_pos + 2] = input[src_pos];
-                    output[dst_pos + 3] = input[src_pos + 3];
-                    break;
-                default:
-                    throw std::runtime_error("Unexpected number of channels: " + std::to_string(channels_));
-            }
+            case 1:
+                std::memcpy(dst, src, output_row_size);
+                break;
+            case 3:
+                kernels_.bgr_to_rgb(src, region_width_, dst);
+                break;
+            case 4:
+                kernels_.bgra_to_rgba(src, region_width_, dst);
+                break;
+            default:
+                throw std::runtime_error("Unexpected number of channels: " + std::to_string(channels_));
         }
     }
-    return output;
 }
 
 }  // namespace perception
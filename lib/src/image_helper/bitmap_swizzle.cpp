@@ -0,0 +1,129 @@
+///
+/// @file bitmap_swizzle.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "perception/image_helper/bitmap_swizzle.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief Swaps pixels [begin, width) of BGR row
+void BgrToRgbScalar(const std::uint8_t* input, const std::int32_t begin, const std::int32_t width,
+                    std::uint8_t* output)
+{
+    for (std::int32_t x = begin; x < width; ++x)
+    {
+        output[3 * x] = input[3 * x + 2];
+        output[3 * x + 1] = input[3 * x + 1];
+        output[3 * x + 2] = input[3 * x];
+    }
+}
+
+/// @brief Swaps pixels [begin, width) of BGRA row
+void BgraToRgbaScalar(const std::uint8_t* input, const std::int32_t begin, const std::int32_t width,
+                      std::uint8_t* output)
+{
+    for (std::int32_t x = begin; x < width; ++x)
+    {
+        output[4 * x] = input[4 * x + 2];
+        output[4 * x + 1] = input[4 * x + 1];
+        output[4 * x + 2] = input[4 * x];
+        output[4 * x + 3] = input[4 * x + 3];
+    }
+}
+
+void BgrToRgbScalar(const std::uint8_t* input, const std::int32_t width, std::uint8_t* output)
+{
+    BgrToRgbScalar(input, 0, width, output);
+}
+
+void BgraToRgbaScalar(const std::uint8_t* input, const std::int32_t width, std::uint8_t* output)
+{
+    BgraToRgbaScalar(input, 0, width, output);
+}
+
+#ifdef PERCEPTION_X86_SIMD
+__attribute__((target("ssse3"))) void BgrToRgbSsse3(const std::uint8_t* input, const std::int32_t width,
+                                                    std::uint8_t* output)
+{
+    // 5 pixels (15 bytes) per 16 byte load/store, last byte is overwritten by the next store
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+    std::int32_t x = 0;
+    for (; (x + 6) <= width; x += 5)
+    {
+        const __m128i bgr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[3 * x]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[3 * x]), _mm_shuffle_epi8(bgr, mask));
+    }
+    BgrToRgbScalar(input, x, width, output);
+}
+
+__attribute__((target("ssse3"))) void BgraToRgbaSsse3(const std::uint8_t* input, const std::int32_t width,
+                                                      std::uint8_t* output)
+{
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    std::int32_t x = 0;
+    for (; (x + 4) <= width; x += 4)
+    {
+        const __m128i bgra = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[4 * x]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[4 * x]), _mm_shuffle_epi8(bgra, mask));
+    }
+    BgraToRgbaScalar(input, x, width, output);
+}
+
+__attribute__((target("avx2"))) void BgrToRgbAvx2(const std::uint8_t* input, const std::int32_t width,
+                                                  std::uint8_t* output)
+{
+    // 4 pixels per lane (bytes 0-11), lanes are packed into bytes 0-23, remaining 8 bytes are overwritten by the
+    // next store
+    const __m256i mask = _mm256_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15,  //
+                                          2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15);
+    const __m256i pack = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    std::int32_t x = 0;
+    for (; (x + 11) <= width; x += 8)
+    {
+        const __m256i bgr = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[3 * x]))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[3 * x + 12])), 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&output[3 * x]),
+                            _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(bgr, mask), pack));
+    }
+    BgrToRgbScalar(input, x, width, output);
+}
+
+__attribute__((target("avx2"))) void BgraToRgbaAvx2(const std::uint8_t* input, const std::int32_t width,
+                                                    std::uint8_t* output)
+{
+    const __m256i mask = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,  //
+                                          2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    std::int32_t x = 0;
+    for (; (x + 8) <= width; x += 8)
+    {
+        const __m256i bgra = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&input[4 * x]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&output[4 * x]), _mm256_shuffle_epi8(bgra, mask));
+    }
+    BgraToRgbaScalar(input, x, width, output);
+}
+#endif
+}  // namespace
+
+BitmapKernels GetBitmapKernels(const InstructionSet instruction_set)
+{
+#ifdef PERCEPTION_X86_SIMD
+    if (instruction_set >= InstructionSet::kAvx2)
+    {
+        return BitmapKernels{BgrToRgbAvx2, BgraToRgbaAvx2};
+    }
+    if (instruction_set >= InstructionSet::kSsse3)
+    {
+        return BitmapKernels{BgrToRgbSsse3, BgraToRgbaSsse3};
+    }
+#endif
+    return BitmapKernels{BgrToRgbScalar, BgraToRgbaScalar};
+}
+
+}  // namespace perception
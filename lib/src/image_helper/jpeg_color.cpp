@@ -0,0 +1,301 @@
+///
+/// @file jpeg_color.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "perception/image_helper/jpeg_color.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief 2x upsampling filter weights (sum up to 128), 4 taps (A-D) within the row, 3 (A-C, X-Z) and 2 (A-B) taps
+///        for the outermost samples
+constexpr std::int16_t kCf4A = -9;
+constexpr std::int16_t kCf4B = 111;
+constexpr std::int16_t kCf4C = 29;
+constexpr std::int16_t kCf4D = -3;
+constexpr std::int16_t kCf3A = 28;
+constexpr std::int16_t kCf3B = 109;
+constexpr std::int16_t kCf3C = -9;
+constexpr std::int16_t kCf3X = 104;
+constexpr std::int16_t kCf3Y = 27;
+constexpr std::int16_t kCf3Z = -3;
+constexpr std::int16_t kCf2A = 139;
+constexpr std::int16_t kCf2B = -11;
+
+inline std::uint8_t Clip(const std::int32_t x)
+{
+    return (x < 0) ? 0 : ((x > 0xFF) ? 0xFF : static_cast<std::uint8_t>(x));
+}
+
+/// @brief Filter output (weights sum up to 128)
+inline std::uint8_t Cf(const std::int32_t x) { return Clip((x + 64) >> 7); }
+
+/// @brief First and last 3 outputs of horizontal 2x upsampling
+void UpsampleRowEdges(const std::uint8_t* input, const std::int32_t input_width, std::uint8_t* output)
+{
+    output[0] = Cf(kCf2A * input[0] + kCf2B * input[1]);
+    output[1] = Cf(kCf3X * input[0] + kCf3Y * input[1] + kCf3Z * input[2]);
+    output[2] = Cf(kCf3A * input[0] + kCf3B * input[1] + kCf3C * input[2]);
+
+    const std::uint8_t* last = &input[input_width - 1];
+    std::uint8_t* end = &output[input_width << 1];
+    end[-3] = Cf(kCf3A * last[0] + kCf3B * last[-1] + kCf3C * last[-2]);
+    end[-2] = Cf(kCf3X * last[0] + kCf3Y * last[-1] + kCf3Z * last[-2]);
+    end[-1] = Cf(kCf2A * last[0] + kCf2B * last[-1]);
+}
+
+/// @brief Outputs 2k + 1 and 2k + 2 of horizontal 2x upsampling, k = [begin, end)
+void UpsampleRowPairs(const std::uint8_t* input, const std::int32_t begin, const std::int32_t end,
+                      std::uint8_t* output)
+{
+    for (std::int32_t k = begin; k < end; ++k)
+    {
+        const std::uint8_t* in = &input[k - 1];
+        output[(k << 1) + 1] = Cf(kCf4A * in[0] + kCf4B * in[1] + kCf4C * in[2] + kCf4D * in[3]);
+        output[(k << 1) + 2] = Cf(kCf4D * in[0] + kCf4C * in[1] + kCf4B * in[2] + kCf4A * in[3]);
+    }
+}
+
+void UpsampleRowScalar(const std::uint8_t* input, const std::int32_t input_width, std::uint8_t* output)
+{
+    UpsampleRowEdges(input, input_width, output);
+    UpsampleRowPairs(input, 1, input_width - 2, output);
+}
+
+void FilterRowsScalar(const std::uint8_t* const* rows, const std::int16_t* weights, const std::int32_t width,
+                      std::uint8_t* output)
+{
+    for (std::int32_t x = 0; x < width; ++x)
+    {
+        output[x] = Cf(weights[0] * rows[0][x] + weights[1] * rows[1][x] + weights[2] * rows[2][x] +
+                       weights[3] * rows[3][x]);
+    }
+}
+
+void ConvertRowScalar(const std::uint8_t* y, const std::uint8_t* cb, const std::uint8_t* cr,
+                      const std::int32_t width, std::uint8_t* rgb)
+{
+    for (std::int32_t x = 0; x < width; ++x)
+    {
+        const std::int32_t luma = y[x] << 8;
+        const std::int32_t blue = cb[x] - 128;
+        const std::int32_t red = cr[x] - 128;
+        *rgb++ = Clip((luma + 359 * red + 128) >> 8);
+        *rgb++ = Clip((luma - 88 * blue - 183 * red + 128) >> 8);
+        *rgb++ = Clip((luma + 454 * blue + 128) >> 8);
+    }
+}
+
+#ifdef PERCEPTION_X86_SIMD
+/// @note SIMD kernels multiply interleaved 16-bit samples of two inputs by a weight pair (pmaddwd), which gives
+///       exact 32-bit sums, thus rounding/shifting/saturating packs match the scalar kernels.
+
+/// @brief Weight pair for pmaddwd, first weight applies to the even (i.e. first unpacked) input
+__attribute__((target("sse2"))) inline __m128i PairWeightsSse2(const std::int16_t first, const std::int16_t second)
+{
+    return _mm_set1_epi32(static_cast<std::int32_t>((static_cast<std::uint32_t>(static_cast<std::uint16_t>(second))
+                                                     << 16) |
+                                                    static_cast<std::uint16_t>(first)));
+}
+
+/// @brief (sum + 64) >> 7 for 2 x 4 sums, saturated to 8 x 16-bit
+__attribute__((target("sse2"))) inline __m128i RoundPairSse2(const __m128i low, const __m128i high)
+{
+    const __m128i rounding = _mm_set1_epi32(64);
+    return _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(low, rounding), 7),
+                           _mm_srai_epi32(_mm_add_epi32(high, rounding), 7));
+}
+
+__attribute__((target("sse2"))) void UpsampleRowSse2(const std::uint8_t* input, const std::int32_t input_width,
+                                                     std::uint8_t* output)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i odd_ab = PairWeightsSse2(kCf4A, kCf4B);
+    const __m128i odd_cd = PairWeightsSse2(kCf4C, kCf4D);
+    const __m128i even_ab = PairWeightsSse2(kCf4D, kCf4C);
+    const __m128i even_cd = PairWeightsSse2(kCf4B, kCf4A);
+
+    UpsampleRowEdges(input, input_width, output);
+
+    // 8 output pairs at once, reads input[k - 1, k + 9]
+    std::int32_t k = 1;
+    for (; k + 8 <= input_width - 2; k += 8)
+    {
+        const __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&input[k - 1])), zero);
+        const __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&input[k])), zero);
+        const __m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&input[k + 1])), zero);
+        const __m128i d = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&input[k + 2])), zero);
+        const __m128i ab_low = _mm_unpacklo_epi16(a, b);
+        const __m128i ab_high = _mm_unpackhi_epi16(a, b);
+        const __m128i cd_low = _mm_unpacklo_epi16(c, d);
+        const __m128i cd_high = _mm_unpackhi_epi16(c, d);
+
+        const __m128i odd =
+            RoundPairSse2(_mm_add_epi32(_mm_madd_epi16(ab_low, odd_ab), _mm_madd_epi16(cd_low, odd_cd)),
+                          _mm_add_epi32(_mm_madd_epi16(ab_high, odd_ab), _mm_madd_epi16(cd_high, odd_cd)));
+        const __m128i even =
+            RoundPairSse2(_mm_add_epi32(_mm_madd_epi16(ab_low, even_ab), _mm_madd_epi16(cd_low, even_cd)),
+                          _mm_add_epi32(_mm_madd_epi16(ab_high, even_ab), _mm_madd_epi16(cd_high, even_cd)));
+
+        // outputs 2k + 1 (odd) and 2k + 2 (even) alternate
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[(k << 1) + 1]),
+                         _mm_unpacklo_epi8(_mm_packus_epi16(odd, odd), _mm_packus_epi16(even, even)));
+    }
+    UpsampleRowPairs(input, k, input_width - 2, output);
+}
+
+__attribute__((target("sse2"))) void FilterRowsSse2(const std::uint8_t* const* rows, const std::int16_t* weights,
+                                                    const std::int32_t width, std::uint8_t* output)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weights_01 = PairWeightsSse2(weights[0], weights[1]);
+    const __m128i weights_23 = PairWeightsSse2(weights[2], weights[3]);
+
+    std::int32_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i r[4];
+        for (std::int32_t i = 0; i < 4; ++i)
+        {
+            r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&rows[i][x]));
+        }
+
+        __m128i half[2];
+        for (std::int32_t h = 0; h < 2; ++h)
+        {
+            const __m128i r0 = h ? _mm_unpackhi_epi8(r[0], zero) : _mm_unpacklo_epi8(r[0], zero);
+            const __m128i r1 = h ? _mm_unpackhi_epi8(r[1], zero) : _mm_unpacklo_epi8(r[1], zero);
+            const __m128i r2 = h ? _mm_unpackhi_epi8(r[2], zero) : _mm_unpacklo_epi8(r[2], zero);
+            const __m128i r3 = h ? _mm_unpackhi_epi8(r[3], zero) : _mm_unpacklo_epi8(r[3], zero);
+            half[h] = RoundPairSse2(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(r0, r1), weights_01),
+                                                  _mm_madd_epi16(_mm_unpacklo_epi16(r2, r3), weights_23)),
+                                    _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(r0, r1), weights_01),
+                                                  _mm_madd_epi16(_mm_unpackhi_epi16(r2, r3), weights_23)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[x]), _mm_packus_epi16(half[0], half[1]));
+    }
+
+    const std::uint8_t* tail[4] = {&rows[0][x], &rows[1][x], &rows[2][x], &rows[3][x]};
+    FilterRowsScalar(tail, weights, width - x, &output[x]);
+}
+
+__attribute__((target("sse2"))) void ConvertRowSse2(const std::uint8_t* y, const std::uint8_t* cb,
+                                                    const std::uint8_t* cr, const std::int32_t width,
+                                                    std::uint8_t* rgb)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i rounding = _mm_set1_epi32(128);
+    const __m128i red_weights = PairWeightsSse2(256, 359);
+    const __m128i green_weights = PairWeightsSse2(256, -88);
+    // rounding is folded into (cr, 1) pair
+    const __m128i green_red_weights = PairWeightsSse2(-183, 128);
+    const __m128i blue_weights = PairWeightsSse2(256, 454);
+
+    alignas(16) std::uint8_t planes[3][16];
+    std::int32_t x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        const __m128i luma8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&y[x]));
+        const __m128i blue8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&cb[x]));
+        const __m128i red8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&cr[x]));
+
+        __m128i red[2], green[2], blue[2];
+        for (std::int32_t h = 0; h < 2; ++h)
+        {
+            const __m128i luma = h ? _mm_unpackhi_epi8(luma8, zero) : _mm_unpacklo_epi8(luma8, zero);
+            const __m128i blue_difference =
+                _mm_sub_epi16(h ? _mm_unpackhi_epi8(blue8, zero) : _mm_unpacklo_epi8(blue8, zero), bias);
+            const __m128i red_difference =
+                _mm_sub_epi16(h ? _mm_unpackhi_epi8(red8, zero) : _mm_unpacklo_epi8(red8, zero), bias);
+
+            __m128i sums[3][2];
+            for (std::int32_t q = 0; q < 2; ++q)
+            {
+                const __m128i luma_red =
+                    q ? _mm_unpackhi_epi16(luma, red_difference) : _mm_unpacklo_epi16(luma, red_difference);
+                const __m128i luma_blue =
+                    q ? _mm_unpackhi_epi16(luma, blue_difference) : _mm_unpacklo_epi16(luma, blue_difference);
+                const __m128i red_one =
+                    q ? _mm_unpackhi_epi16(red_difference, one) : _mm_unpacklo_epi16(red_difference, one);
+                sums[0][q] = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(luma_red, red_weights), rounding), 8);
+                sums[1][q] = _mm_srai_epi32(
+                    _mm_add_epi32(_mm_madd_epi16(luma_blue, green_weights), _mm_madd_epi16(red_one, green_red_weights)),
+                    8);
+                sums[2][q] = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(luma_blue, blue_weights), rounding), 8);
+            }
+            red[h] = _mm_packs_epi32(sums[0][0], sums[0][1]);
+            green[h] = _mm_packs_epi32(sums[1][0], sums[1][1]);
+            blue[h] = _mm_packs_epi32(sums[2][0], sums[2][1]);
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(planes[0]), _mm_packus_epi16(red[0], red[1]));
+        _mm_store_si128(reinterpret_cast<__m128i*>(planes[1]), _mm_packus_epi16(green[0], green[1]));
+        _mm_store_si128(reinterpret_cast<__m128i*>(planes[2]), _mm_packus_epi16(blue[0], blue[1]));
+
+        // SSE2 lacks byte shuffles, interleaving stays scalar
+        for (std::int32_t i = 0; i < 16; ++i)
+        {
+            *rgb++ = planes[0][i];
+            *rgb++ = planes[1][i];
+            *rgb++ = planes[2][i];
+        }
+    }
+    ConvertRowScalar(&y[x], &cb[x], &cr[x], width - x, rgb);
+}
+#endif
+
+}  // namespace
+
+UpsampleTaps GetUpsampleTaps(const std::int32_t output_index, const std::int32_t input_size)
+{
+    const std::int32_t last = input_size - 1;
+    const std::int32_t reversed_index = (input_size << 1) - 1 - output_index;
+    UpsampleTaps taps{};
+    if (output_index < 3 || reversed_index < 3)
+    {
+        // edges mirror each other
+        const std::int32_t edge = (output_index < 3) ? output_index : reversed_index;
+        const std::int32_t direction = (output_index < 3) ? 1 : -1;
+        const std::int32_t origin = (output_index < 3) ? 0 : last;
+        const std::int16_t weights[3][3] = {
+            {kCf2A, kCf2B, 0}, {kCf3X, kCf3Y, kCf3Z}, {kCf3A, kCf3B, kCf3C}};
+        for (std::int32_t i = 0; i < 3; ++i)
+        {
+            taps.index[i] = origin + direction * i;
+            taps.weight[i] = weights[edge][i];
+        }
+        taps.index[3] = origin;
+        taps.weight[3] = 0;
+        return taps;
+    }
+
+    // output 2k + 1 (A, B, C, D) or 2k + 2 (D, C, B, A) from inputs k - 1 to k + 2
+    const bool odd = (output_index & 1) != 0;
+    const std::int32_t k = (output_index - (odd ? 1 : 2)) >> 1;
+    const std::int16_t weights[4] = {kCf4A, kCf4B, kCf4C, kCf4D};
+    for (std::int32_t i = 0; i < 4; ++i)
+    {
+        taps.index[i] = k - 1 + i;
+        taps.weight[i] = odd ? weights[i] : weights[3 - i];
+    }
+    return taps;
+}
+
+ColorKernels GetColorKernels(const InstructionSet instruction_set)
+{
+#ifdef PERCEPTION_X86_SIMD
+    if (instruction_set >= InstructionSet::kSse2)
+    {
+        return ColorKernels{UpsampleRowSse2, FilterRowsSse2, ConvertRowSse2};
+    }
+#endif
+    return ColorKernels{UpsampleRowScalar, FilterRowsScalar, ConvertRowScalar};
+}
+
+}  // namespace perception
@@ -2,37 +2,177 @@
 /// @file jpeg_helper.cpp
 /// @copyright Copyright (c) 2020. All Rights Reserved.
 ///
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <fstream>
+#include <stdexcept>
+#include <string>
 
 #include "perception/image_helper/jpeg_helper.h"
+#include "perception/utils/mapped_file.h"
 
 namespace perception
 {
-JpegImageHelper::JpegImageHelper() {}
+JpegImageHelper::JpegImageHelper()
+    : arena_{},
+      jpeg_decoder_{std::make_unique<Jpeg::Decoder>(malloc, free, GetSupportedInstructionSet(), &arena_)},
+      thread_pool_{},
+      decode_options_{}
+{
+}
 JpegImageHelper::~JpegImageHelper() {}
 
 std::vector<std::uint8_t> JpegImageHelper::ReadImage(const std::string& image_path, std::int32_t* width,
                                                      std::int32_t* height, std::int32_t* channels)
 {
-    std::ifstream jpeg_image{image_path};
-    std::string jpeg_data((std::istreambuf_iterator<char>(jpeg_image)), std::istreambuf_iterator<char>());
-    jpeg_decoder_ = std::make_unique<Jpeg::Decoder>(jpeg_data.c_str(), jpeg_data.size());
+    return DecodeImage(ReadImageView(image_path, width, height, channels));
+}
+
+ImageInfo JpegImageHelper::Probe(const std::string& image_path) const
+{
+    std::ifstream file(image_path, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Input file " + image_path + " not found");
+    }
+
+    std::array<std::uint8_t, 2> marker{};
+    if (!file.read(reinterpret_cast<char*>(marker.data()), marker.size()) || (marker[0] != 0xFF) ||
+        (marker[1] != 0xD8))
+    {
+        throw std::runtime_error("Input file " + image_path + " is not a JPG file");
+    }
+
+    // marker segments (marker, length) up to the frame header (SOF0-SOF15, except DHT, JPG and DAC). Any marker may
+    // be preceded by fill bytes, i.e. further 0xFF
+    while (file.get() == 0xFF)
+    {
+        auto type = file.get();
+        while (type == 0xFF)
+        {
+            type = file.get();
+        }
+        if ((type == std::char_traits<char>::eof()) || !file.read(reinterpret_cast<char*>(marker.data()), 2))
+        {
+            break;
+        }
+        const auto length = static_cast<std::int32_t>((marker[0] << 8) | marker[1]);
+        if (((type & 0xF0) != 0xC0) || (type == 0xC4) || (type == 0xC8) || (type == 0xCC))
+        {
+            if ((type == 0xDA) || (length < 2))
+            {
+                break;
+            }
+            file.seekg(length - 2, std::ios::cur);
+            continue;
+        }
+
+        // precision, height, width, number of components and (id, sampling factors, quantization table) of each
+        std::array<std::uint8_t, 6 + 3 * 3> frame_header{};
+        if (!file.read(reinterpret_cast<char*>(frame_header.data()), 6))
+        {
+            break;
+        }
+        // decoder supports grayscale and YCbCr only (i.e. neither CMYK nor YCCK)
+        const std::int32_t components = frame_header[5];
+        if ((components != 1) && (components != 3))
+        {
+            throw std::runtime_error("Input file " + image_path + " has unsupported number of components: " +
+                                     std::to_string(components));
+        }
+        if (!file.read(reinterpret_cast<char*>(&frame_header[6]), 3 * components))
+        {
+            break;
+        }
+
+        ImageInfo info{};
+        info.format = ImageFormat::kJpeg;
+        info.height = (frame_header[1] << 8) | frame_header[2];
+        info.width = (frame_header[3] << 8) | frame_header[4];
+        // channels of decoded image, see ReadImageView()
+        info.channels = ((components == 3) && !decode_options_.lumaOnly) ? 3 : 1;
+        std::int32_t max_horizontal = 1;
+        std::int32_t max_vertical = 1;
+        std::int32_t min_horizontal = 4;
+        std::int32_t min_vertical = 4;
+        for (std::int32_t component = 0; component < components; ++component)
+        {
+            const auto sampling_factors = frame_header[6 + 3 * component + 1];
+            max_horizontal = std::max(max_horizontal, sampling_factors >> 4);
+            max_vertical = std::max(max_vertical, sampling_factors & 15);
+            min_horizontal = std::max(1, std::min(min_horizontal, sampling_factors >> 4));
+            min_vertical = std::max(1, std::min(min_vertical, sampling_factors & 15));
+        }
+        info.horizontal_subsampling = std::max(1, max_horizontal / min_horizontal);
+        info.vertical_subsampling = std::max(1, max_vertical / min_vertical);
+        return info;
+    }
+    throw std::runtime_error("Input file " + image_path + " has no JPG frame header");
+}
+
+const std::uint8_t* JpegImageHelper::ReadImageView(const std::string& image_path, std::int32_t* width,
+                                                   std::int32_t* height, std::int32_t* channels)
+{
+    if (!width || !height || !channels)
+    {
+        throw std::runtime_error("Received nullptr for width/height/channels.");
+    }
+
+    // decoder only reads the compressed data while decoding, thus mapping can be dropped right after. previous
+    // image (arena buffers) is released beforehand, so that it can be reused
+    {
+        const MappedFile jpeg_file{image_path};
+        arena_.Reset();
+        jpeg_decoder_->Decode(reinterpret_cast<const char*>(jpeg_file.GetData()), jpeg_file.GetSize(),
+                              decode_options_);
+    }
+    if (jpeg_decoder_->GetResult() != Jpeg::Decoder::OK)
+    {
+        throw std::runtime_error("Failed to decode " + image_path + " (error " +
+                                 std::to_string(jpeg_decoder_->GetResult()) + ")");
+    }
 
     *width = jpeg_decoder_->GetWidth();
     *height = jpeg_decoder_->GetHeight();
     *channels = jpeg_decoder_->IsColor() ? 3 : 1;
 
-    return DecodeImage(jpeg_decoder_->GetImage());
+    return jpeg_decoder_->GetImage();
 }
 
-std::vector<std::uint8_t> JpegImageHelper::DecodeImage(const std::uint8_t* input) const
+void JpegImageHelper::SetMinimumSize(const std::int32_t width, const std::int32_t height)
 {
-    std::vector<uint8_t> output(jpeg_decoder_->GetImageSize());
-    for (std::size_t i = 0; i < output.size(); ++i)
+    decode_options_.minWidth = width;
+    decode_options_.minHeight = height;
+}
+
+void JpegImageHelper::SetNumberOfThreads(const std::int32_t number_of_threads)
+{
+    if (number_of_threads > 1)
     {
-        output[i] = input[i];
+        thread_pool_ = std::make_unique<ThreadPool>(static_cast<std::size_t>(number_of_threads));
     }
-    return output;
+    else
+    {
+        thread_pool_.reset();
+    }
+    decode_options_.threadPool = thread_pool_.get();
+}
+
+void JpegImageHelper::SetRegionOfInterest(const std::int32_t x, const std::int32_t y, const std::int32_t width,
+                                          const std::int32_t height)
+{
+    decode_options_.cropX = x;
+    decode_options_.cropY = y;
+    decode_options_.cropWidth = width;
+    decode_options_.cropHeight = height;
+}
+
+void JpegImageHelper::SetLumaOnly(const bool luma_only) { decode_options_.lumaOnly = luma_only; }
+
+std::vector<std::uint8_t> JpegImageHelper::DecodeImage(const std::uint8_t* input) const
+{
+    return std::vector<std::uint8_t>(input, input + jpeg_decoder_->GetImageSize());
 }
 
 }  // namespace perception
\ No newline at end of file
@@ -0,0 +1,543 @@
+///
+/// @file jpeg_idct.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "perception/image_helper/jpeg_idct.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief IDCT constants, 2048 * sqrt(2) * cos(k * pi / 16)
+constexpr std::int32_t kW1 = 2841;
+constexpr std::int32_t kW2 = 2676;
+constexpr std::int32_t kW3 = 2408;
+constexpr std::int32_t kW5 = 1609;
+constexpr std::int32_t kW6 = 1108;
+constexpr std::int32_t kW7 = 565;
+
+/// @brief 256 / sqrt(2)
+constexpr std::int32_t kR2 = 181;
+
+/// @brief Reduced IDCT basis (Q12), 4096 * a(u) * cos((2i + 1) * u * pi / 2N) with a(0) = 1, a(u > 0) = sqrt(2).
+///        It evaluates the 8-point IDCT of the lowest N x N coefficients at the centers of (8 / N)^2 pixel cells.
+constexpr std::int32_t kReducedBasis4[4][4] = {
+    {4096, 5352, 4096, 2217}, {4096, 2217, -4096, -5352}, {4096, -2217, -4096, 5352}, {4096, -5352, 4096, -2217}};
+constexpr std::int32_t kReducedBasis2[2][2] = {{4096, 4096}, {4096, -4096}};
+
+inline std::uint8_t Clip(const std::int32_t x)
+{
+    return (x < 0) ? 0 : ((x > 0xFF) ? 0xFF : static_cast<std::uint8_t>(x));
+}
+
+/// @brief Horizontal pass (in place) on single row
+void InverseDctRow(std::int32_t* blk)
+{
+    std::int32_t x0, x1, x2, x3, x4, x5, x6, x7, x8;
+    if (!((x1 = blk[4] << 11) | (x2 = blk[6]) | (x3 = blk[2]) | (x4 = blk[1]) | (x5 = blk[7]) | (x6 = blk[5]) |
+          (x7 = blk[3])))
+    {
+        blk[0] = blk[1] = blk[2] = blk[3] = blk[4] = blk[5] = blk[6] = blk[7] = blk[0] << 3;
+        return;
+    }
+    x0 = (blk[0] << 11) + 128;
+    x8 = kW7 * (x4 + x5);
+    x4 = x8 + (kW1 - kW7) * x4;
+    x5 = x8 - (kW1 + kW7) * x5;
+    x8 = kW3 * (x6 + x7);
+    x6 = x8 - (kW3 - kW5) * x6;
+    x7 = x8 - (kW3 + kW5) * x7;
+    x8 = x0 + x1;
+    x0 -= x1;
+    x1 = kW6 * (x3 + x2);
+    x2 = x1 - (kW2 + kW6) * x2;
+    x3 = x1 + (kW2 - kW6) * x3;
+    x1 = x4 + x6;
+    x4 -= x6;
+    x6 = x5 + x7;
+    x5 -= x7;
+    x7 = x8 + x3;
+    x8 -= x3;
+    x3 = x0 + x2;
+    x0 -= x2;
+    x2 = (kR2 * (x4 + x5) + 128) >> 8;
+    x4 = (kR2 * (x4 - x5) + 128) >> 8;
+    blk[0] = (x7 + x1) >> 8;
+    blk[1] = (x3 + x2) >> 8;
+    blk[2] = (x0 + x4) >> 8;
+    blk[3] = (x8 + x6) >> 8;
+    blk[4] = (x8 - x6) >> 8;
+    blk[5] = (x0 - x4) >> 8;
+    blk[6] = (x3 - x2) >> 8;
+    blk[7] = (x7 - x1) >> 8;
+}
+
+/// @brief Vertical pass on single column, writes (level shifted and clipped) pixels
+void InverseDctColumn(const std::int32_t* blk, std::uint8_t* out, const std::int32_t stride)
+{
+    std::int32_t x0, x1, x2, x3, x4, x5, x6, x7, x8;
+    if (!((x1 = blk[8 * 4] << 8) | (x2 = blk[8 * 6]) | (x3 = blk[8 * 2]) | (x4 = blk[8 * 1]) | (x5 = blk[8 * 7]) |
+          (x6 = blk[8 * 5]) | (x7 = blk[8 * 3])))
+    {
+        x1 = Clip(((blk[0] + 32) >> 6) + 128);
+        for (x0 = 8; x0; --x0)
+        {
+            *out = static_cast<std::uint8_t>(x1);
+            out += stride;
+        }
+        return;
+    }
+    x0 = (blk[0] << 8) + 8192;
+    x8 = kW7 * (x4 + x5) + 4;
+    x4 = (x8 + (kW1 - kW7) * x4) >> 3;
+    x5 = (x8 - (kW1 + kW7) * x5) >> 3;
+    x8 = kW3 * (x6 + x7) + 4;
+    x6 = (x8 - (kW3 - kW5) * x6) >> 3;
+    x7 = (x8 - (kW3 + kW5) * x7) >> 3;
+    x8 = x0 + x1;
+    x0 -= x1;
+    x1 = kW6 * (x3 + x2) + 4;
+    x2 = (x1 - (kW2 + kW6) * x2) >> 3;
+    x3 = (x1 + (kW2 - kW6) * x3) >> 3;
+    x1 = x4 + x6;
+    x4 -= x6;
+    x6 = x5 + x7;
+    x5 -= x7;
+    x7 = x8 + x3;
+    x8 -= x3;
+    x3 = x0 + x2;
+    x0 -= x2;
+    x2 = (kR2 * (x4 + x5) + 128) >> 8;
+    x4 = (kR2 * (x4 - x5) + 128) >> 8;
+    *out = Clip(((x7 + x1) >> 14) + 128);
+    out += stride;
+    *out = Clip(((x3 + x2) >> 14) + 128);
+    out += stride;
+    *out = Clip(((x0 + x4) >> 14) + 128);
+    out += stride;
+    *out = Clip(((x8 + x6) >> 14) + 128);
+    out += stride;
+    *out = Clip(((x8 - x6) >> 14) + 128);
+    out += stride;
+    *out = Clip(((x0 - x4) >> 14) + 128);
+    out += stride;
+    *out = Clip(((x3 - x2) >> 14) + 128);
+    out += stride;
+    *out = Clip(((x7 - x1) >> 14) + 128);
+}
+
+void InverseDctScalar(std::int32_t* block, std::uint8_t* output, const std::int32_t stride)
+{
+    for (std::int32_t row = 0; row < 64; row += 8)
+    {
+        InverseDctRow(&block[row]);
+    }
+    for (std::int32_t column = 0; column < 8; ++column)
+    {
+        InverseDctColumn(&block[column], &output[column], stride);
+    }
+}
+
+/// @brief N x N output from lowest N x N coefficients (i.e. block downscaled by 8 / N within DCT domain)
+template <std::int32_t N>
+void InverseDctReduced(const std::int32_t (&basis)[N][N], const std::int32_t* block, std::uint8_t* output,
+                       const std::int32_t stride)
+{
+    // rows (Q12), 64-bit as dequantized coefficients may use up to ~20 bits
+    std::int64_t rows[N][N];
+    for (std::int32_t v = 0; v < N; ++v)
+    {
+        for (std::int32_t i = 0; i < N; ++i)
+        {
+            std::int64_t sum = 0;
+            for (std::int32_t u = 0; u < N; ++u)
+            {
+                sum += static_cast<std::int64_t>(basis[i][u]) * block[v * 8 + u];
+            }
+            rows[v][i] = sum;
+        }
+    }
+
+    // columns (Q24), pixel = sum / 8 (same normalization as 8-point IDCT)
+    for (std::int32_t j = 0; j < N; ++j)
+    {
+        for (std::int32_t i = 0; i < N; ++i)
+        {
+            std::int64_t sum = 0;
+            for (std::int32_t v = 0; v < N; ++v)
+            {
+                sum += basis[j][v] * rows[v][i];
+            }
+            const std::int64_t value = ((sum + (std::int64_t{1} << 26)) >> 27) + 128;
+            output[j * stride + i] = (value < 0) ? 0 : ((value > 0xFF) ? 0xFF : static_cast<std::uint8_t>(value));
+        }
+    }
+}
+
+void InverseDct4x4(std::int32_t* block, std::uint8_t* output, const std::int32_t stride)
+{
+    InverseDctReduced<4>(kReducedBasis4, block, output, stride);
+}
+
+void InverseDct2x2(std::int32_t* block, std::uint8_t* output, const std::int32_t stride)
+{
+    InverseDctReduced<2>(kReducedBasis2, block, output, stride);
+}
+
+/// @brief Block average, i.e. (DC + 4) / 8 as the full IDCT does without AC coefficients
+void InverseDct1x1(std::int32_t* block, std::uint8_t* output, const std::int32_t)
+{
+    *output = Clip(((block[0] + 4) >> 3) + 128);
+}
+
+#ifdef PERCEPTION_X86_SIMD
+/// @note SIMD kernels evaluate the full butterflies on all lanes and then select the result of the all-zero AC
+///       shortcut of the scalar passes per lane. The shortcut matches the full path unless 32-bit arithmetic
+///       overflows (i.e. corrupt coefficients), thus selecting it keeps kernels bit-exact for any input.
+
+/// @brief Low 32 bits of a * factor (SSE2 lacks pmulld, sign does not matter for the low half)
+__attribute__((target("sse2"))) inline __m128i MultiplySse2(const __m128i a, const std::int32_t factor)
+{
+    const __m128i b = _mm_set1_epi32(factor);
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), b);
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/// @brief Transposes 4x4 matrix of 32-bit elements
+__attribute__((target("sse2"))) inline void Transpose4x4Sse2(__m128i* a, __m128i* b, __m128i* c, __m128i* d)
+{
+    const __m128i t0 = _mm_unpacklo_epi32(*a, *b);
+    const __m128i t1 = _mm_unpacklo_epi32(*c, *d);
+    const __m128i t2 = _mm_unpackhi_epi32(*a, *b);
+    const __m128i t3 = _mm_unpackhi_epi32(*c, *d);
+    *a = _mm_unpacklo_epi64(t0, t1);
+    *b = _mm_unpackhi_epi64(t0, t1);
+    *c = _mm_unpacklo_epi64(t2, t3);
+    *d = _mm_unpackhi_epi64(t2, t3);
+}
+
+/// @brief 1-D IDCT on 4 lanes, x[k] holds coefficient k of each lane.
+///        Row pass keeps results in place, column pass additionally level shifts (not yet clipped).
+template <bool kColumnPass>
+__attribute__((target("sse2"))) void InverseDct1dSse2(__m128i* x)
+{
+    const std::int32_t shift = kColumnPass ? 8 : 11;
+    const __m128i bias = _mm_set1_epi32(kColumnPass ? 8192 : 128);
+    const __m128i four = _mm_set1_epi32(4);
+    const __m128i round = _mm_set1_epi32(128);
+
+    __m128i x0 = _mm_add_epi32(_mm_slli_epi32(x[0], shift), bias);
+    __m128i x1 = _mm_slli_epi32(x[4], shift);
+    __m128i x2 = x[6];
+    __m128i x3 = x[2];
+    __m128i x4 = x[1];
+    __m128i x5 = x[7];
+    __m128i x6 = x[5];
+    __m128i x7 = x[3];
+
+    // lanes without AC coefficients take the shortcut of the scalar pass (differs from full path on overflow)
+    const __m128i ac = _mm_or_si128(_mm_or_si128(_mm_or_si128(x1, x2), _mm_or_si128(x3, x4)),
+                                    _mm_or_si128(_mm_or_si128(x5, x6), x7));
+    const __m128i dc_only = _mm_cmpeq_epi32(ac, _mm_setzero_si128());
+    const __m128i dc = kColumnPass ? _mm_srai_epi32(_mm_add_epi32(x[0], _mm_set1_epi32(32)), 6)
+                                   : _mm_slli_epi32(x[0], 3);
+
+    __m128i x8 = MultiplySse2(_mm_add_epi32(x4, x5), kW7);
+    if (kColumnPass)
+    {
+        x8 = _mm_add_epi32(x8, four);
+        x4 = _mm_srai_epi32(_mm_add_epi32(x8, MultiplySse2(x4, kW1 - kW7)), 3);
+        x5 = _mm_srai_epi32(_mm_sub_epi32(x8, MultiplySse2(x5, kW1 + kW7)), 3);
+        x8 = _mm_add_epi32(MultiplySse2(_mm_add_epi32(x6, x7), kW3), four);
+        x6 = _mm_srai_epi32(_mm_sub_epi32(x8, MultiplySse2(x6, kW3 - kW5)), 3);
+        x7 = _mm_srai_epi32(_mm_sub_epi32(x8, MultiplySse2(x7, kW3 + kW5)), 3);
+    }
+    else
+    {
+        x4 = _mm_add_epi32(x8, MultiplySse2(x4, kW1 - kW7));
+        x5 = _mm_sub_epi32(x8, MultiplySse2(x5, kW1 + kW7));
+        x8 = MultiplySse2(_mm_add_epi32(x6, x7), kW3);
+        x6 = _mm_sub_epi32(x8, MultiplySse2(x6, kW3 - kW5));
+        x7 = _mm_sub_epi32(x8, MultiplySse2(x7, kW3 + kW5));
+    }
+    x8 = _mm_add_epi32(x0, x1);
+    x0 = _mm_sub_epi32(x0, x1);
+    x1 = MultiplySse2(_mm_add_epi32(x3, x2), kW6);
+    if (kColumnPass)
+    {
+        x1 = _mm_add_epi32(x1, four);
+        x2 = _mm_srai_epi32(_mm_sub_epi32(x1, MultiplySse2(x2, kW2 + kW6)), 3);
+        x3 = _mm_srai_epi32(_mm_add_epi32(x1, MultiplySse2(x3, kW2 - kW6)), 3);
+    }
+    else
+    {
+        x2 = _mm_sub_epi32(x1, MultiplySse2(x2, kW2 + kW6));
+        x3 = _mm_add_epi32(x1, MultiplySse2(x3, kW2 - kW6));
+    }
+    x1 = _mm_add_epi32(x4, x6);
+    x4 = _mm_sub_epi32(x4, x6);
+    x6 = _mm_add_epi32(x5, x7);
+    x5 = _mm_sub_epi32(x5, x7);
+    x7 = _mm_add_epi32(x8, x3);
+    x8 = _mm_sub_epi32(x8, x3);
+    x3 = _mm_add_epi32(x0, x2);
+    x0 = _mm_sub_epi32(x0, x2);
+    x2 = _mm_srai_epi32(_mm_add_epi32(MultiplySse2(_mm_add_epi32(x4, x5), kR2), round), 8);
+    x4 = _mm_srai_epi32(_mm_add_epi32(MultiplySse2(_mm_sub_epi32(x4, x5), kR2), round), 8);
+
+    const std::int32_t output_shift = kColumnPass ? 14 : 8;
+    x[0] = _mm_srai_epi32(_mm_add_epi32(x7, x1), output_shift);
+    x[1] = _mm_srai_epi32(_mm_add_epi32(x3, x2), output_shift);
+    x[2] = _mm_srai_epi32(_mm_add_epi32(x0, x4), output_shift);
+    x[3] = _mm_srai_epi32(_mm_add_epi32(x8, x6), output_shift);
+    x[4] = _mm_srai_epi32(_mm_sub_epi32(x8, x6), output_shift);
+    x[5] = _mm_srai_epi32(_mm_sub_epi32(x0, x4), output_shift);
+    x[6] = _mm_srai_epi32(_mm_sub_epi32(x3, x2), output_shift);
+    x[7] = _mm_srai_epi32(_mm_sub_epi32(x7, x1), output_shift);
+    for (std::int32_t k = 0; k < 8; ++k)
+    {
+        x[k] = _mm_or_si128(_mm_and_si128(dc_only, dc), _mm_andnot_si128(dc_only, x[k]));
+    }
+    if (kColumnPass)
+    {
+        const __m128i level_shift = _mm_set1_epi32(128);
+        for (std::int32_t k = 0; k < 8; ++k)
+        {
+            x[k] = _mm_add_epi32(x[k], level_shift);
+        }
+    }
+}
+
+/// @brief Block is processed as 4x4 quadrants: rows (resp. columns) 0-3 and 4-7 share each pass
+__attribute__((target("sse2"))) void InverseDctSse2(std::int32_t* block, std::uint8_t* output,
+                                                    const std::int32_t stride)
+{
+    // rows[half][k] holds coefficient k of rows 4 * half .. 4 * half + 3
+    __m128i rows[2][8];
+    for (std::int32_t half = 0; half < 2; ++half)
+    {
+        for (std::int32_t quadrant = 0; quadrant < 2; ++quadrant)
+        {
+            __m128i* x = &rows[half][4 * quadrant];
+            for (std::int32_t i = 0; i < 4; ++i)
+            {
+                x[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&block[(4 * half + i) * 8 + 4 * quadrant]));
+            }
+            Transpose4x4Sse2(&x[0], &x[1], &x[2], &x[3]);
+        }
+        InverseDct1dSse2<false>(rows[half]);
+    }
+
+    // columns[half][j] holds row j of columns 4 * half .. 4 * half + 3
+    __m128i columns[2][8];
+    for (std::int32_t half = 0; half < 2; ++half)
+    {
+        for (std::int32_t quadrant = 0; quadrant < 2; ++quadrant)
+        {
+            __m128i* x = &columns[half][4 * quadrant];
+            for (std::int32_t i = 0; i < 4; ++i)
+            {
+                x[i] = rows[quadrant][4 * half + i];
+            }
+            Transpose4x4Sse2(&x[0], &x[1], &x[2], &x[3]);
+        }
+        InverseDct1dSse2<true>(columns[half]);
+    }
+
+    // saturating packs clip to [0, 255]
+    for (std::int32_t j = 0; j < 8; ++j)
+    {
+        const __m128i packed = _mm_packs_epi32(columns[0][j], columns[1][j]);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&output[j * stride]), _mm_packus_epi16(packed, packed));
+    }
+}
+
+/// @brief Transposes 8x8 matrix of 32-bit elements
+__attribute__((target("avx2"))) inline void Transpose8x8Avx2(__m256i* v)
+{
+    const __m256i t0 = _mm256_unpacklo_epi32(v[0], v[1]);
+    const __m256i t1 = _mm256_unpackhi_epi32(v[0], v[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(v[2], v[3]);
+    const __m256i t3 = _mm256_unpackhi_epi32(v[2], v[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(v[4], v[5]);
+    const __m256i t5 = _mm256_unpackhi_epi32(v[4], v[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(v[6], v[7]);
+    const __m256i t7 = _mm256_unpackhi_epi32(v[6], v[7]);
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    v[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    v[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    v[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    v[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    v[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    v[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    v[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    v[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+__attribute__((target("avx2"))) inline __m256i MultiplyAvx2(const __m256i a, const std::int32_t factor)
+{
+    return _mm256_mullo_epi32(a, _mm256_set1_epi32(factor));
+}
+
+/// @brief 1-D IDCT on 8 lanes, see InverseDct1dSse2()
+template <bool kColumnPass>
+__attribute__((target("avx2"))) void InverseDct1dAvx2(__m256i* x)
+{
+    const std::int32_t shift = kColumnPass ? 8 : 11;
+    const __m256i bias = _mm256_set1_epi32(kColumnPass ? 8192 : 128);
+    const __m256i four = _mm256_set1_epi32(4);
+    const __m256i round = _mm256_set1_epi32(128);
+
+    __m256i x0 = _mm256_add_epi32(_mm256_slli_epi32(x[0], shift), bias);
+    __m256i x1 = _mm256_slli_epi32(x[4], shift);
+    __m256i x2 = x[6];
+    __m256i x3 = x[2];
+    __m256i x4 = x[1];
+    __m256i x5 = x[7];
+    __m256i x6 = x[5];
+    __m256i x7 = x[3];
+
+    // lanes without AC coefficients take the shortcut of the scalar pass (differs from full path on overflow)
+    const __m256i ac = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(x1, x2), _mm256_or_si256(x3, x4)),
+                                       _mm256_or_si256(_mm256_or_si256(x5, x6), x7));
+    const __m256i dc_only = _mm256_cmpeq_epi32(ac, _mm256_setzero_si256());
+    const __m256i dc = kColumnPass ? _mm256_srai_epi32(_mm256_add_epi32(x[0], _mm256_set1_epi32(32)), 6)
+                                   : _mm256_slli_epi32(x[0], 3);
+
+    __m256i x8 = MultiplyAvx2(_mm256_add_epi32(x4, x5), kW7);
+    if (kColumnPass)
+    {
+        x8 = _mm256_add_epi32(x8, four);
+        x4 = _mm256_srai_epi32(_mm256_add_epi32(x8, MultiplyAvx2(x4, kW1 - kW7)), 3);
+        x5 = _mm256_srai_epi32(_mm256_sub_epi32(x8, MultiplyAvx2(x5, kW1 + kW7)), 3);
+        x8 = _mm256_add_epi32(MultiplyAvx2(_mm256_add_epi32(x6, x7), kW3), four);
+        x6 = _mm256_srai_epi32(_mm256_sub_epi32(x8, MultiplyAvx2(x6, kW3 - kW5)), 3);
+        x7 = _mm256_srai_epi32(_mm256_sub_epi32(x8, MultiplyAvx2(x7, kW3 + kW5)), 3);
+    }
+    else
+    {
+        x4 = _mm256_add_epi32(x8, MultiplyAvx2(x4, kW1 - kW7));
+        x5 = _mm256_sub_epi32(x8, MultiplyAvx2(x5, kW1 + kW7));
+        x8 = MultiplyAvx2(_mm256_add_epi32(x6, x7), kW3);
+        x6 = _mm256_sub_epi32(x8, MultiplyAvx2(x6, kW3 - kW5));
+        x7 = _mm256_sub_epi32(x8, MultiplyAvx2(x7, kW3 + kW5));
+    }
+    x8 = _mm256_add_epi32(x0, x1);
+    x0 = _mm256_sub_epi32(x0, x1);
+    x1 = MultiplyAvx2(_mm256_add_epi32(x3, x2), kW6);
+    if (kColumnPass)
+    {
+        x1 = _mm256_add_epi32(x1, four);
+        x2 = _mm256_srai_epi32(_mm256_sub_epi32(x1, MultiplyAvx2(x2, kW2 + kW6)), 3);
+        x3 = _mm256_srai_epi32(_mm256_add_epi32(x1, MultiplyAvx2(x3, kW2 - kW6)), 3);
+    }
+    else
+    {
+        x2 = _mm256_sub_epi32(x1, MultiplyAvx2(x2, kW2 + kW6));
+        x3 = _mm256_add_epi32(x1, MultiplyAvx2(x3, kW2 - kW6));
+    }
+    x1 = _mm256_add_epi32(x4, x6);
+    x4 = _mm256_sub_epi32(x4, x6);
+    x6 = _mm256_add_epi32(x5, x7);
+    x5 = _mm256_sub_epi32(x5, x7);
+    x7 = _mm256_add_epi32(x8, x3);
+    x8 = _mm256_sub_epi32(x8, x3);
+    x3 = _mm256_add_epi32(x0, x2);
+    x0 = _mm256_sub_epi32(x0, x2);
+    x2 = _mm256_srai_epi32(_mm256_add_epi32(MultiplyAvx2(_mm256_add_epi32(x4, x5), kR2), round), 8);
+    x4 = _mm256_srai_epi32(_mm256_add_epi32(MultiplyAvx2(_mm256_sub_epi32(x4, x5), kR2), round), 8);
+
+    const std::int32_t output_shift = kColumnPass ? 14 : 8;
+    x[0] = _mm256_srai_epi32(_mm256_add_epi32(x7, x1), output_shift);
+    x[1] = _mm256_srai_epi32(_mm256_add_epi32(x3, x2), output_shift);
+    x[2] = _mm256_srai_epi32(_mm256_add_epi32(x0, x4), output_shift);
+    x[3] = _mm256_srai_epi32(_mm256_add_epi32(x8, x6), output_shift);
+    x[4] = _mm256_srai_epi32(_mm256_sub_epi32(x8, x6), output_shift);
+    x[5] = _mm256_srai_epi32(_mm256_sub_epi32(x0, x4), output_shift);
+    x[6] = _mm256_srai_epi32(_mm256_sub_epi32(x3, x2), output_shift);
+    x[7] = _mm256_srai_epi32(_mm256_sub_epi32(x7, x1), output_shift);
+    for (std::int32_t k = 0; k < 8; ++k)
+    {
+        x[k] = _mm256_or_si256(_mm256_and_si256(dc_only, dc), _mm256_andnot_si256(dc_only, x[k]));
+    }
+    if (kColumnPass)
+    {
+        const __m256i level_shift = _mm256_set1_epi32(128);
+        for (std::int32_t k = 0; k < 8; ++k)
+        {
+            x[k] = _mm256_add_epi32(x[k], level_shift);
+        }
+    }
+}
+
+__attribute__((target("avx2"))) void InverseDctAvx2(std::int32_t* block, std::uint8_t* output,
+                                                    const std::int32_t stride)
+{
+    __m256i x[8];
+    for (std::int32_t row = 0; row < 8; ++row)
+    {
+        x[row] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&block[row * 8]));
+    }
+
+    // lanes are rows, then columns
+    Transpose8x8Avx2(x);
+    InverseDct1dAvx2<false>(x);
+    Transpose8x8Avx2(x);
+    InverseDct1dAvx2<true>(x);
+
+    // saturating packs clip to [0, 255]
+    for (std::int32_t j = 0; j < 8; ++j)
+    {
+        const __m128i packed =
+            _mm_packs_epi32(_mm256_castsi256_si128(x[j]), _mm256_extracti128_si256(x[j], 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&output[j * stride]), _mm_packus_epi16(packed, packed));
+    }
+}
+#endif
+
+}  // namespace
+
+InverseDctFunction GetInverseDct(const InstructionSet instruction_set)
+{
+#ifdef PERCEPTION_X86_SIMD
+    if (instruction_set >= InstructionSet::kAvx2)
+    {
+        return InverseDctAvx2;
+    }
+    if (instruction_set >= InstructionSet::kSse2)
+    {
+        return InverseDctSse2;
+    }
+#endif
+    return InverseDctScalar;
+}
+
+InverseDctFunction GetScaledInverseDct(const std::int32_t scale_shift, const InstructionSet instruction_set)
+{
+    switch (scale_shift)
+    {
+        case 1:
+            return InverseDct4x4;
+        case 2:
+            return InverseDct2x2;
+        case 3:
+            return InverseDct1x1;
+        default:
+            return GetInverseDct(instruction_set);
+    }
+}
+
+}  // namespace perception
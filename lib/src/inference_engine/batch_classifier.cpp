@@ -0,0 +1,235 @@
+///
+/// @file batch_classifier.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <experimental/filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+
+#include "perception/image_helper/bitmap_helper.h"
+#include "perception/image_helper/jpeg_helper.h"
+#include "perception/inference_engine/batch_classifier.h"
+#include "perception/inference_engine/top_results.h"
+#include "perception/logging/logging.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief Elapsed time since given start (ms)
+double GetElapsedTime(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Is given file a BMP or JPEG image (by extension)?
+bool IsImageFile(const std::string& path)
+{
+    const auto extension = absl::AsciiStrToLower(std::experimental::filesystem::path{path}.extension().string());
+    return (extension == ".bmp") || (extension == ".jpg") || (extension == ".jpeg");
+}
+
+}  // namespace
+
+struct BatchClassifier::Worker
+{
+    Worker(const float input_mean, const float input_std, const std::size_t input_bytes)
+        : bitmap_helper{}, jpeg_helper{}, preprocessing_engine{input_mean, input_std}, tensor(input_bytes)
+    {
+    }
+
+    BitmapImageHelper bitmap_helper;
+    JpegImageHelper jpeg_helper;
+    PreprocessingEngine preprocessing_engine;
+    std::vector<std::uint8_t> tensor;
+};
+
+BatchClassifier::BatchClassifier(InterpreterPool* pool, const float input_mean, const float input_std,
+                                 const std::int32_t number_of_results, const std::size_t number_of_workers)
+    : pool_{pool},
+      input_mean_{input_mean},
+      input_std_{input_std},
+      number_of_results_{number_of_results},
+      number_of_workers_{number_of_workers},
+      input_type_{kTfLiteNoType},
+      input_params_{},
+      input_dims_{},
+      input_bytes_{0U},
+      next_index_{0U},
+      result_mutex_{},
+      statistics_{},
+      error_{}
+{
+    ASSERT_CHECK(pool_) << "Batch Classifier requires an interpreter pool";
+    ASSERT_CHECK(number_of_workers_ > 0U) << "Batch Classifier requires at least one worker";
+
+    const auto interpreter = pool_->Acquire();
+    const auto input = interpreter->tensor(interpreter->inputs()[0]);
+    input_type_ = input->type;
+    input_params_ = input->params;
+    input_dims_ = ImageDimensions{input->dims->data[1], input->dims->data[2], input->dims->data[3]};
+    input_bytes_ = input->bytes;
+}
+
+BatchClassifier::~BatchClassifier() {}
+
+BatchStatistics BatchClassifier::Run(const std::vector<std::string>& image_paths, const ResultCallback& callback)
+{
+    next_index_ = 0U;
+    statistics_ = BatchStatistics{};
+    error_ = nullptr;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (std::size_t worker = 0U; worker < std::min(number_of_workers_, image_paths.size()); ++worker)
+    {
+        workers.emplace_back([&]() { Work(image_paths, callback); });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    statistics_.wall_time_ms = GetElapsedTime(start);
+    statistics_.images_per_second =
+        (statistics_.wall_time_ms > 0.0) ? (statistics_.images * 1000.0 / statistics_.wall_time_ms) : 0.0;
+
+    if (error_)
+    {
+        std::rethrow_exception(error_);
+    }
+    return statistics_;
+}
+
+std::vector<std::string> BatchClassifier::ListImages(const std::string& path)
+{
+    namespace fs = std::experimental::filesystem;
+    if (!fs::exists(path))
+    {
+        throw std::runtime_error(path + " does not exists!!");
+    }
+
+    std::vector<std::string> image_paths;
+    if (fs::is_directory(path))
+    {
+        for (const auto& entry : fs::directory_iterator{path})
+        {
+            if (fs::is_regular_file(entry.status()) && IsImageFile(entry.path().string()))
+            {
+                image_paths.push_back(entry.path().string());
+            }
+        }
+        std::sort(image_paths.begin(), image_paths.end());
+        return image_paths;
+    }
+
+    std::ifstream manifest{path};
+    ASSERT_CHECK(manifest.is_open()) << "Unable to open " << path;
+    std::string line;
+    while (std::getline(manifest, line))
+    {
+        const auto image_path = absl::StripAsciiWhitespace(line);
+        if (!image_path.empty() && !absl::StartsWith(image_path, "#"))
+        {
+            image_paths.emplace_back(image_path);
+        }
+    }
+    return image_paths;
+}
+
+void BatchClassifier::Work(const std::vector<std::string>& image_paths, const ResultCallback& callback)
+{
+    Worker worker{input_mean_, input_std_, input_bytes_};
+    worker.jpeg_helper.SetMinimumSize(input_dims_.width, input_dims_.height);
+    worker.jpeg_helper.SetLumaOnly(input_dims_.channels == 1);
+
+    for (auto index = next_index_++; index < image_paths.size(); index = next_index_++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        BatchResult result{};
+        result.image_index = index;
+        result.image_path = image_paths[index];
+        try
+        {
+            result.results = Classify(result.image_path, &worker);
+        }
+        catch (const std::exception& e)
+        {
+            result.error = e.what();
+        }
+        result.latency_ms = GetElapsedTime(start);
+
+        std::lock_guard<std::mutex> lock{result_mutex_};
+        if (error_)
+        {
+            break;
+        }
+        if (result.error.empty())
+        {
+            ++statistics_.images;
+            statistics_.latency.Add(result.latency_ms);
+        }
+        else
+        {
+            ++statistics_.failures;
+        }
+        try
+        {
+            callback(result);
+        }
+        catch (...)
+        {
+            // skips remaining images, on all the workers
+            error_ = std::current_exception();
+            next_index_ = image_paths.size();
+        }
+    }
+}
+
+std::vector<std::pair<float, std::int32_t>> BatchClassifier::Classify(const std::string& image_path, Worker* worker)
+{
+    IImageHelper& image_helper = absl::EndsWith(absl::AsciiStrToLower(image_path), ".bmp")
+                                     ? static_cast<IImageHelper&>(worker->bitmap_helper)
+                                     : static_cast<IImageHelper&>(worker->jpeg_helper);
+    ImageDimensions image_dims{};
+    const auto image_data =
+        image_helper.ReadImageView(image_path, &image_dims.width, &image_dims.height, &image_dims.channels);
+
+    auto& tensor = worker->tensor;
+    switch (input_type_)
+    {
+        case TfLiteType::kTfLiteFloat32:
+            worker->preprocessing_engine.Resize(image_data, image_dims, input_dims_,
+                                                reinterpret_cast<float*>(tensor.data()));
+            break;
+        case TfLiteType::kTfLiteUInt8:
+            worker->preprocessing_engine.Resize(image_data, image_dims, input_dims_, input_params_, tensor.data());
+            break;
+        case TfLiteType::kTfLiteInt8:
+            worker->preprocessing_engine.Resize(image_data, image_dims, input_dims_, input_params_,
+                                                reinterpret_cast<std::int8_t*>(tensor.data()));
+            break;
+        default:
+            throw std::runtime_error("cannot handle input type " + std::to_string(input_type_) + " yet");
+    }
+
+    // interpreter is leased for invoke and top results only, decode/preprocess of other workers overlap with it
+    const auto interpreter = pool_->Acquire();
+    const auto input_tensor = interpreter->tensor(interpreter->inputs()[0]);
+    std::memcpy(input_tensor->data.raw, tensor.data(), input_bytes_);
+    if (interpreter->Invoke() != TfLiteStatus::kTfLiteOk)
+    {
+        throw std::runtime_error("Failed to invoke tflite!");
+    }
+    const auto output_tensor = interpreter->tensor(interpreter->outputs()[0]);
+    return GetTopResults(output_tensor->type, output_tensor->params, output_tensor->data.raw_const,
+                         output_tensor->dims->data[output_tensor->dims->size - 1], number_of_results_);
+}
+
+}  // namespace perception
@@ -0,0 +1,103 @@
+///
+/// @file batch_result_writer.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <stdexcept>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+
+#include "perception/inference_engine/batch_result_writer.h"
+#include "perception/utils/json.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief Writes value as CSV field (quoted, if it contains separators, quotes or line breaks)
+void WriteCsvField(std::ostream& stream, const absl::string_view value)
+{
+    if (value.find_first_of(",\"\r\n") == absl::string_view::npos)
+    {
+        stream << value;
+        return;
+    }
+    stream << '"';
+    for (const char c : value)
+    {
+        stream << c;
+        if (c == '"')
+        {
+            stream << '"';
+        }
+    }
+    stream << '"';
+}
+
+}  // namespace
+
+BatchResultWriter::BatchResultWriter(const std::string& path, const LabelTable& labels)
+    : file_{path, std::ios::out | std::ios::trunc},
+      format_{absl::EndsWith(absl::AsciiStrToLower(path), ".csv") ? Format::kCsv : Format::kJsonLines},
+      labels_{labels}
+{
+    if (!file_.is_open())
+    {
+        throw std::runtime_error("Unable to open " + path);
+    }
+    if (format_ == Format::kCsv)
+    {
+        file_ << "image,rank,index,label,confidence,latency_ms,error\n";
+    }
+}
+
+void BatchResultWriter::Write(const BatchResult& result)
+{
+    if (format_ == Format::kCsv)
+    {
+        if (result.results.empty())
+        {
+            WriteCsvField(file_, result.image_path);
+            file_ << ",,,,," << result.latency_ms << ',';
+            WriteCsvField(file_, result.error);
+            file_ << '\n';
+        }
+        for (std::size_t rank = 0U; rank < result.results.size(); ++rank)
+        {
+            const auto& entry = result.results[rank];
+            WriteCsvField(file_, result.image_path);
+            file_ << ',' << rank << ',' << entry.second << ',';
+            WriteCsvField(file_, labels_.Get(entry.second));
+            file_ << ',' << entry.first << ',' << result.latency_ms << ",\n";
+        }
+    }
+    else
+    {
+        file_ << "{\"image\": ";
+        WriteJsonString(file_, result.image_path);
+        file_ << ", \"latency_ms\": " << result.latency_ms << ", \"results\": [";
+        for (std::size_t rank = 0U; rank < result.results.size(); ++rank)
+        {
+            const auto& entry = result.results[rank];
+            file_ << ((rank > 0U) ? ", " : "") << "{\"index\": " << entry.second << ", \"label\": ";
+            WriteJsonString(file_, labels_.Get(entry.second));
+            file_ << ", \"confidence\": " << entry.first << '}';
+        }
+        file_ << ']';
+        if (!result.error.empty())
+        {
+            file_ << ", \"error\": ";
+            WriteJsonString(file_, result.error);
+        }
+        file_ << "}\n";
+    }
+
+    if (!file_)
+    {
+        throw std::runtime_error("Failed to write batch result of " + result.image_path);
+    }
+}
+
+BatchResultWriter::Format BatchResultWriter::GetFormat() const { return format_; }
+
+}  // namespace perception
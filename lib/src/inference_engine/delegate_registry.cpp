@@ -0,0 +1,62 @@
+///
+/// @file delegate_registry.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <stdexcept>
+
+#include "tensorflow/lite/tools/evaluation/utils.h"
+
+#include "perception/inference_engine/delegate_registry.h"
+
+namespace perception
+{
+constexpr const char* DelegateRegistry::kNoDelegate;
+
+DelegateRegistry& DelegateRegistry::GetInstance()
+{
+    static DelegateRegistry registry;
+    return registry;
+}
+
+DelegateRegistry::DelegateRegistry() : factories_{}, mutex_{}
+{
+    factories_[kNoDelegate] = []() {
+        return tflite::Interpreter::TfLiteDelegatePtr{nullptr, [](TfLiteDelegate*) {}};
+    };
+    // NNAPI is available on Android only, elsewhere factory provides nullptr
+    factories_["nnapi"] = []() { return tflite::evaluation::CreateNNAPIDelegate(); };
+}
+
+void DelegateRegistry::Register(const std::string& name, const DelegateFactory& factory)
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    factories_[name] = factory;
+}
+
+tflite::Interpreter::TfLiteDelegatePtr DelegateRegistry::Create(const std::string& name) const
+{
+    DelegateFactory factory;
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        const auto it = factories_.find(name);
+        if (it == factories_.end())
+        {
+            throw std::runtime_error("Delegate {" + name + "} is not registered");
+        }
+        factory = it->second;
+    }
+    return factory();
+}
+
+std::vector<std::string> DelegateRegistry::GetNames() const
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    std::vector<std::string> names;
+    for (const auto& entry : factories_)
+    {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+}  // namespace perception
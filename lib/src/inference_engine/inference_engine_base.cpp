@@ -2,9 +2,9 @@
 /// @file inference_engine_base.cpp
 /// @copyright Copyright (c) 2020. All Rights Reserved.
 ///
+#include <algorithm>
 #include <cstdint>
 #include <experimental/filesystem>
-#include <fstream>
 
 #include "absl/strings/match.h"
 
@@ -31,7 +31,14 @@ InferenceEngineBase::InferenceEngineBase(const CLIOptions& cli_options)
 {
     ASSERT_PATH_EXISTS(cli_options_.model_name);
     ASSERT_PATH_EXISTS(cli_options_.labels_name);
-    ASSERT_PATH_EXISTS(cli_options_.input_name);
+    if (cli_options_.batch_input.empty())
+    {
+        ASSERT_PATH_EXISTS(cli_options_.input_name);
+    }
+    else
+    {
+        ASSERT_PATH_EXISTS(cli_options_.batch_input);
+    }
 
     if (absl::EndsWith(cli_options_.input_name, ".bmp"))
     {
@@ -41,37 +48,40 @@ InferenceEngineBase::InferenceEngineBase(const CLIOptions& cli_options)
     {
         image_helper_ = std::make_unique<JpegImageHelper>();
     }
+    image_helper_->SetNumberOfThreads(cli_options_.decode_threads);
+    image_helper_->SetRegionOfInterest(cli_options_.roi_x, cli_options_.roi_y, cli_options_.roi_width,
+                                       cli_options_.roi_height);
 }
 
 InferenceEngineBase::~InferenceEngineBase() {}
 
-std::vector<std::string> InferenceEngineBase::GetLabelList() const
+void InferenceEngineBase::LoadLabels()
 {
-    std::vector<std::string> labels;
-    std::ifstream file(cli_options_.labels_name);
-    ASSERT_CHECK(file.is_open()) << "Labels file " << cli_options_.labels_name << " not found";
-
-    labels.clear();
-    std::string line;
-    while (std::getline(file, line))
-    {
-        labels.push_back(line);
-    }
-    /// @note It pads with empty strings so the length
-    /// of the result is a multiple of 16, because our model expects that.
-    const std::int32_t padding = 16;
-    while (labels.size() % padding)
-    {
-        labels.emplace_back();
-    }
-    return labels;
+    ASSERT_CHECK(std::experimental::filesystem::exists(cli_options_.labels_name))
+        << "Labels file " << cli_options_.labels_name << " not found";
+    labels_ = LabelTable::Load(cli_options_.labels_name);
+    LOG(INFO) << "Loaded " << labels_.GetSize() << " labels";
 }
 
+const LabelTable& InferenceEngineBase::GetLabels() const { return labels_; }
+
 std::vector<std::uint8_t> InferenceEngineBase::GetImageData()
 {
     return image_helper_->ReadImage(cli_options_.input_name, &width_, &height_, &channels_);
 }
 
+const std::uint8_t* InferenceEngineBase::GetImageView()
+{
+    return image_helper_->ReadImageView(cli_options_.input_name, &width_, &height_, &channels_);
+}
+
+void InferenceEngineBase::SetImageMinimumSize(const std::int32_t width, const std::int32_t height)
+{
+    image_helper_->SetMinimumSize(width, height);
+}
+
+void InferenceEngineBase::SetImageLumaOnly(const bool luma_only) { image_helper_->SetLumaOnly(luma_only); }
+
 std::int32_t InferenceEngineBase::GetImageWidth() const { return width_; }
 std::int32_t InferenceEngineBase::GetImageHeight() const { return height_; }
 std::int32_t InferenceEngineBase::GetImageChannels() const { return channels_; }
@@ -102,4 +112,23 @@ std::string InferenceEngineBase::GetResultDirectory() const
 float InferenceEngineBase::GetInputMean() const { return cli_options_.input_mean; }
 float InferenceEngineBase::GetInputStd() const { return cli_options_.input_std; }
 std::int32_t InferenceEngineBase::GetLoopCount() const { return cli_options_.loop_count; }
+bool InferenceEngineBase::IsBenchmarkEnabled() const { return cli_options_.benchmark; }
+std::int32_t InferenceEngineBase::GetWarmupRuns() const { return cli_options_.warmup_runs; }
+bool InferenceEngineBase::IsPipelineEnabled() const { return cli_options_.pipeline; }
+std::int32_t InferenceEngineBase::GetNumberOfDecodeThreads() const { return cli_options_.decode_threads; }
+RegionOfInterest InferenceEngineBase::GetRegionOfInterest() const
+{
+    return RegionOfInterest{cli_options_.roi_x, cli_options_.roi_y, cli_options_.roi_width, cli_options_.roi_height};
+}
+std::string InferenceEngineBase::GetDelegateName() const { return cli_options_.delegate; }
+
+std::size_t InferenceEngineBase::GetInputCacheSize() const
+{
+    return static_cast<std::size_t>(std::max(cli_options_.input_cache_mb, 0)) << 20U;
+}
+
+bool InferenceEngineBase::IsBatchModeEnabled() const { return !cli_options_.batch_input.empty(); }
+std::string InferenceEngineBase::GetBatchInput() const { return cli_options_.batch_input; }
+std::int32_t InferenceEngineBase::GetBatchWorkers() const { return std::max(cli_options_.batch_workers, 1); }
+std::string InferenceEngineBase::GetBatchOutput() const { return cli_options_.batch_output; }
 }  // namespace perception
@@ -0,0 +1,179 @@
+///
+/// @file interpreter_pool.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <utility>
+
+#include "perception/inference_engine/interpreter_pool.h"
+#include "perception/logging/logging.h"
+#include "perception/op_resolver/op_resolver.h"
+
+namespace perception
+{
+InterpreterPool::Lease::Lease() : pool_{nullptr}, index_{0U} {}
+
+InterpreterPool::Lease::Lease(InterpreterPool* pool, const std::size_t index) : pool_{pool}, index_{index} {}
+
+InterpreterPool::Lease::Lease(Lease&& other) noexcept : pool_{other.pool_}, index_{other.index_}
+{
+    other.pool_ = nullptr;
+}
+
+InterpreterPool::Lease& InterpreterPool::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        pool_ = other.pool_;
+        index_ = other.index_;
+        other.pool_ = nullptr;
+    }
+    return *this;
+}
+
+InterpreterPool::Lease::~Lease() { Reset(); }
+
+tflite::Interpreter* InterpreterPool::Lease::get() const
+{
+    return pool_ ? pool_->interpreters_[index_].get() : nullptr;
+}
+
+tflite::Interpreter* InterpreterPool::Lease::operator->() const { return get(); }
+
+InterpreterPool::Lease::operator bool() const { return pool_ != nullptr; }
+
+void InterpreterPool::Lease::Reset()
+{
+    if (pool_)
+    {
+        pool_->Release(index_);
+        pool_ = nullptr;
+    }
+}
+
+InterpreterPool::InterpreterPool(const std::string& model_path, const std::size_t number_of_interpreters,
+                                 const std::int32_t threads_per_interpreter)
+    : owned_model_{tflite::FlatBufferModel::BuildFromFile(model_path.c_str())},
+      model_{owned_model_.get()},
+      interpreters_{},
+      in_use_{},
+      next_{0U},
+      mutex_{},
+      interpreter_available_{},
+      waiters_{0U}
+{
+    ASSERT_CHECK(model_) << "Failed to mmap model " << model_path;
+    BuildInterpreters(number_of_interpreters, threads_per_interpreter);
+}
+
+InterpreterPool::InterpreterPool(const tflite::FlatBufferModel& model, const std::size_t number_of_interpreters,
+                                 const std::int32_t threads_per_interpreter)
+    : owned_model_{},
+      model_{&model},
+      interpreters_{},
+      in_use_{},
+      next_{0U},
+      mutex_{},
+      interpreter_available_{},
+      waiters_{0U}
+{
+    BuildInterpreters(number_of_interpreters, threads_per_interpreter);
+}
+
+InterpreterPool::~InterpreterPool() {}
+
+InterpreterPool::Lease InterpreterPool::TryAcquire()
+{
+    const auto size = interpreters_.size();
+    const auto start = next_.fetch_add(1U, std::memory_order_relaxed);
+    for (std::size_t i = 0U; i < size; ++i)
+    {
+        const auto index = (start + i) % size;
+        // sequentially consistent, i.e. either this checkout sees the flag cleared by Release() or Release() sees
+        // the waiter registered by Acquire() before it
+        bool expected = false;
+        if (in_use_[index].compare_exchange_strong(expected, true))
+        {
+            return Lease{this, index};
+        }
+    }
+    return Lease{};
+}
+
+InterpreterPool::Lease InterpreterPool::Acquire()
+{
+    auto lease = TryAcquire();
+    if (lease)
+    {
+        return lease;
+    }
+
+    // slow path, i.e. all interpreters are in use: sleep until Release() returns one
+    std::unique_lock<std::mutex> lock{mutex_};
+    waiters_.fetch_add(1U);
+    lease = TryAcquire();
+    while (!lease)
+    {
+        interpreter_available_.wait(lock);
+        lease = TryAcquire();
+    }
+    waiters_.fetch_sub(1U);
+    return lease;
+}
+
+std::size_t InterpreterPool::GetSize() const { return interpreters_.size(); }
+
+std::size_t InterpreterPool::GetAvailableCount() const
+{
+    std::size_t available = 0U;
+    for (std::size_t index = 0U; index < interpreters_.size(); ++index)
+    {
+        if (!in_use_[index].load(std::memory_order_relaxed))
+        {
+            ++available;
+        }
+    }
+    return available;
+}
+
+const tflite::FlatBufferModel& InterpreterPool::GetModel() const { return *model_; }
+
+void InterpreterPool::BuildInterpreters(const std::size_t number_of_interpreters,
+                                        const std::int32_t threads_per_interpreter)
+{
+    ASSERT_CHECK(number_of_interpreters > 0U) << "Interpreter Pool requires at least one interpreter";
+
+    in_use_ = std::make_unique<std::atomic<bool>[]>(number_of_interpreters);
+    const auto resolver = CreateOpResolver();
+    for (std::size_t index = 0U; index < number_of_interpreters; ++index)
+    {
+        std::unique_ptr<tflite::Interpreter> interpreter;
+        tflite::InterpreterBuilder(*model_, *resolver)(&interpreter);
+        ASSERT_CHECK(interpreter) << "Failed to construct interpreter";
+
+        if (-1 != threads_per_interpreter)
+        {
+            interpreter->SetNumThreads(threads_per_interpreter);
+        }
+        if (interpreter->AllocateTensors() != TfLiteStatus::kTfLiteOk)
+        {
+            LOG(FATAL) << "Failed to allocate tensors!";
+        }
+
+        interpreters_.push_back(std::move(interpreter));
+        in_use_[index].store(false);
+    }
+}
+
+void InterpreterPool::Release(const std::size_t index)
+{
+    in_use_[index].store(false);
+    if (waiters_.load() > 0U)
+    {
+        // waiter either still holds the mutex (and checks out this interpreter before waiting) or is waiting already
+        std::lock_guard<std::mutex> lock{mutex_};
+        interpreter_available_.notify_one();
+    }
+}
+
+}  // namespace perception
@@ -0,0 +1,303 @@
+///
+/// @file pipeline_executor.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "absl/strings/match.h"
+
+#include "perception/image_helper/bitmap_helper.h"
+#include "perception/image_helper/jpeg_helper.h"
+#include "perception/inference_engine/pipeline_executor.h"
+#include "perception/inference_engine/top_results.h"
+#include "perception/logging/logging.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief Stage indices (into counters)
+constexpr std::size_t kDecodeStage = 0U;
+constexpr std::size_t kPreprocessStage = 1U;
+constexpr std::size_t kInvokeStage = 2U;
+constexpr std::size_t kPostprocessStage = 3U;
+
+/// @brief Stage names, in stage order
+constexpr const char* kStageNames[] = {"decode", "preprocess", "invoke", "postprocess"};
+
+/// @brief Elapsed time since given start (ms)
+double GetElapsedTime(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+PipelineExecutor::PipelineExecutor(tflite::Interpreter* interpreter, const float input_mean, const float input_std,
+                                   const std::int32_t number_of_results, const std::size_t queue_capacity)
+    : interpreter_{interpreter},
+      preprocessing_engine_{input_mean, input_std},
+      number_of_results_{number_of_results},
+      input_type_{kTfLiteNoType},
+      input_params_{},
+      input_dims_{},
+      input_bytes_{0U},
+      queue_capacity_{queue_capacity},
+      decode_threads_{1},
+      region_of_interest_{},
+      counters_{},
+      wall_time_ms_{0.0},
+      error_{},
+      error_mutex_{},
+      aborted_{false}
+{
+    ASSERT_CHECK(interpreter_) << "Pipeline requires an interpreter";
+    ASSERT_CHECK(queue_capacity_ > 0U) << "Pipeline requires non-empty queues";
+
+    const auto input = interpreter_->tensor(interpreter_->inputs()[0]);
+    input_type_ = input->type;
+    input_params_ = input->params;
+    input_dims_ = ImageDimensions{input->dims->data[1], input->dims->data[2], input->dims->data[3]};
+    input_bytes_ = input->bytes;
+}
+
+PipelineExecutor::~PipelineExecutor() {}
+
+void PipelineExecutor::SetNumberOfDecodeThreads(const std::int32_t number_of_threads)
+{
+    decode_threads_ = number_of_threads;
+}
+
+void PipelineExecutor::SetRegionOfInterest(const RegionOfInterest& region_of_interest)
+{
+    region_of_interest_ = region_of_interest;
+}
+
+std::vector<PipelineResult> PipelineExecutor::Run(const std::vector<std::string>& image_paths,
+                                                  const ResultCallback& callback)
+{
+    std::fill(std::begin(counters_), std::end(counters_), StageCounters{});
+    error_ = nullptr;
+    aborted_ = false;
+
+    std::vector<PipelineResult> results;
+    results.reserve(image_paths.size());
+
+    SpscQueue<Frame> decoded_queue{queue_capacity_};
+    SpscQueue<Frame> preprocessed_queue{queue_capacity_};
+    SpscQueue<Frame> inferred_queue{queue_capacity_};
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread decode_thread{[&]() { Decode(image_paths, &decoded_queue); }};
+    std::thread preprocess_thread{[&]() { Preprocess(&decoded_queue, &preprocessed_queue); }};
+    std::thread invoke_thread{[&]() { Invoke(&preprocessed_queue, &inferred_queue); }};
+    std::thread postprocess_thread{[&]() { Postprocess(image_paths, callback, &inferred_queue, &results); }};
+
+    decode_thread.join();
+    preprocess_thread.join();
+    invoke_thread.join();
+    postprocess_thread.join();
+    wall_time_ms_ = GetElapsedTime(start);
+
+    if (error_)
+    {
+        std::rethrow_exception(error_);
+    }
+    return results;
+}
+
+std::vector<StageStatistics> PipelineExecutor::GetStageStatistics() const
+{
+    std::vector<StageStatistics> statistics;
+    for (std::size_t stage = kDecodeStage; stage <= kPostprocessStage; ++stage)
+    {
+        const auto& counters = counters_[stage];
+        StageStatistics stage_statistics{};
+        stage_statistics.name = kStageNames[stage];
+        stage_statistics.frames = counters.frames;
+        stage_statistics.busy_time_ms = counters.busy_time_ms;
+        stage_statistics.occupancy = (wall_time_ms_ > 0.0) ? (counters.busy_time_ms / wall_time_ms_) : 0.0;
+        stage_statistics.average_queue_size =
+            (counters.frames > 0U) ? (static_cast<double>(counters.queue_size_sum) / counters.frames) : 0.0;
+        statistics.push_back(stage_statistics);
+    }
+    return statistics;
+}
+
+void PipelineExecutor::Decode(const std::vector<std::string>& image_paths, SpscQueue<Frame>* output)
+{
+    try
+    {
+        BitmapImageHelper bitmap_helper;
+        JpegImageHelper jpeg_helper;
+        jpeg_helper.SetMinimumSize(input_dims_.width, input_dims_.height);
+        jpeg_helper.SetLumaOnly(input_dims_.channels == 1);
+        for (IImageHelper* image_helper : {static_cast<IImageHelper*>(&bitmap_helper),
+                                           static_cast<IImageHelper*>(&jpeg_helper)})
+        {
+            image_helper->SetNumberOfThreads(decode_threads_);
+            image_helper->SetRegionOfInterest(region_of_interest_.x, region_of_interest_.y,
+                                              region_of_interest_.width, region_of_interest_.height);
+        }
+        auto& counters = counters_[kDecodeStage];
+        for (std::size_t index = 0U; (index < image_paths.size()) && !aborted_; ++index)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            IImageHelper& image_helper = absl::EndsWith(image_paths[index], ".bmp")
+                                             ? static_cast<IImageHelper&>(bitmap_helper)
+                                             : static_cast<IImageHelper&>(jpeg_helper);
+            Frame frame{};
+            frame.index = index;
+            frame.image.data = image_helper.ReadImage(image_paths[index], &frame.image.width, &frame.image.height,
+                                                      &frame.image.channels);
+            counters.busy_time_ms += GetElapsedTime(start);
+            ++counters.frames;
+
+            if (!output->Push(std::move(frame)))
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        Abort(std::current_exception());
+    }
+    output->Close();
+}
+
+void PipelineExecutor::Preprocess(SpscQueue<Frame>* input, SpscQueue<Frame>* output)
+{
+    try
+    {
+        auto& counters = counters_[kPreprocessStage];
+        Frame frame{};
+        while (!aborted_ && input->Pop(&frame))
+        {
+            counters.queue_size_sum += input->GetSize();
+            const auto start = std::chrono::steady_clock::now();
+            const ImageDimensions image_dims{frame.image.height, frame.image.width, frame.image.channels};
+            frame.tensor.resize(input_bytes_);
+            switch (input_type_)
+            {
+                case TfLiteType::kTfLiteFloat32:
+                    preprocessing_engine_.Resize(frame.image.data.data(), image_dims, input_dims_,
+                                                 reinterpret_cast<float*>(frame.tensor.data()));
+                    break;
+                case TfLiteType::kTfLiteUInt8:
+                    preprocessing_engine_.Resize(frame.image.data.data(), image_dims, input_dims_, input_params_,
+                                                 frame.tensor.data());
+                    break;
+                case TfLiteType::kTfLiteInt8:
+                    preprocessing_engine_.Resize(frame.image.data.data(), image_dims, input_dims_, input_params_,
+                                                 reinterpret_cast<std::int8_t*>(frame.tensor.data()));
+                    break;
+                default:
+                    throw std::runtime_error("cannot handle input type " + std::to_string(input_type_) + " yet");
+            }
+            counters.busy_time_ms += GetElapsedTime(start);
+            ++counters.frames;
+
+            if (!output->Push(std::move(frame)))
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        Abort(std::current_exception());
+    }
+    // unblocks producer, in case this stage stopped early
+    input->Close();
+    output->Close();
+}
+
+void PipelineExecutor::Invoke(SpscQueue<Frame>* input, SpscQueue<Frame>* output)
+{
+    try
+    {
+        auto& counters = counters_[kInvokeStage];
+        const auto input_tensor = interpreter_->tensor(interpreter_->inputs()[0]);
+        const auto output_tensor = interpreter_->tensor(interpreter_->outputs()[0]);
+        Frame frame{};
+        while (!aborted_ && input->Pop(&frame))
+        {
+            counters.queue_size_sum += input->GetSize();
+            const auto start = std::chrono::steady_clock::now();
+            std::memcpy(input_tensor->data.raw, frame.tensor.data(), input_tensor->bytes);
+            const auto error_code = interpreter_->Invoke();
+            if (error_code != TfLiteStatus::kTfLiteOk)
+            {
+                throw std::runtime_error("Failed to invoke tflite!");
+            }
+            frame.tensor.assign(output_tensor->data.raw_const, output_tensor->data.raw_const + output_tensor->bytes);
+            counters.busy_time_ms += GetElapsedTime(start);
+            ++counters.frames;
+
+            if (!output->Push(std::move(frame)))
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        Abort(std::current_exception());
+    }
+    input->Close();
+    output->Close();
+}
+
+void PipelineExecutor::Postprocess(const std::vector<std::string>& image_paths, const ResultCallback& callback,
+                                   SpscQueue<Frame>* input, std::vector<PipelineResult>* results)
+{
+    try
+    {
+        auto& counters = counters_[kPostprocessStage];
+        const auto output_tensor = interpreter_->tensor(interpreter_->outputs()[0]);
+        const auto output_type = output_tensor->type;
+        const auto output_params = output_tensor->params;
+        const auto output_size = output_tensor->dims->data[output_tensor->dims->size - 1];
+        Frame frame{};
+        while (!aborted_ && input->Pop(&frame))
+        {
+            counters.queue_size_sum += input->GetSize();
+            const auto start = std::chrono::steady_clock::now();
+            PipelineResult result{};
+            result.frame_index = frame.index;
+            result.image_path = image_paths[frame.index];
+            result.results =
+                GetTopResults(output_type, output_params, frame.tensor.data(), output_size, number_of_results_);
+            if (callback)
+            {
+                callback(result);
+            }
+            results->push_back(std::move(result));
+            counters.busy_time_ms += GetElapsedTime(start);
+            ++counters.frames;
+        }
+    }
+    catch (...)
+    {
+        Abort(std::current_exception());
+    }
+    input->Close();
+}
+
+void PipelineExecutor::Abort(const std::exception_ptr& error)
+{
+    std::lock_guard<std::mutex> lock{error_mutex_};
+    if (!error_)
+    {
+        error_ = error;
+    }
+    aborted_ = true;
+}
+
+}  // namespace perception
@@ -0,0 +1,90 @@
+///
+/// @file preprocessing_engine.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "perception/inference_engine/preprocessing_engine.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief Maximum number of distinct shapes kept in the cache. (Cache is flushed once exceeded)
+constexpr std::size_t kMaxCachedShapes = 8U;
+}  // namespace
+
+PreprocessingEngine::PreprocessingEngine(const float input_mean, const float input_std)
+    : input_mean_{input_mean}, input_std_{input_std}, cache_{}, uint8_table_{}, int8_table_{}
+{
+}
+
+PreprocessingEngine::~PreprocessingEngine() {}
+
+void PreprocessingEngine::Resize(const std::uint8_t* input, const ImageDimensions& input_dims,
+                                 const ImageDimensions& output_dims, float* output)
+{
+    // (x - input_mean) / input_std, folded into the resize pass
+    GetResizer(input_dims, output_dims, kTfLiteFloat32)
+        ->Resize(input, 1.0F / input_std_, -input_mean_ / input_std_, output);
+}
+
+void PreprocessingEngine::Resize(const std::uint8_t* input, const ImageDimensions& input_dims,
+                                 const ImageDimensions& output_dims, std::uint8_t* output)
+{
+    GetResizer(input_dims, output_dims, kTfLiteUInt8)->Resize(input, output);
+}
+
+void PreprocessingEngine::Resize(const std::uint8_t* input, const ImageDimensions& input_dims,
+                                 const ImageDimensions& output_dims, const TfLiteQuantizationParams& params,
+                                 std::uint8_t* output)
+{
+    GetResizer(input_dims, output_dims, kTfLiteUInt8)
+        ->Resize(input, GetQuantizationTable(params, &uint8_table_), output);
+}
+
+void PreprocessingEngine::Resize(const std::uint8_t* input, const ImageDimensions& input_dims,
+                                 const ImageDimensions& output_dims, const TfLiteQuantizationParams& params,
+                                 std::int8_t* output)
+{
+    GetResizer(input_dims, output_dims, kTfLiteInt8)->Resize(input, GetQuantizationTable(params, &int8_table_), output);
+}
+
+std::size_t PreprocessingEngine::GetCacheSize() const { return cache_.size(); }
+
+BilinearResizer* PreprocessingEngine::GetResizer(const ImageDimensions& input_dims, const ImageDimensions& output_dims,
+                                                 const TfLiteType output_type)
+{
+    const auto key = std::make_tuple(input_dims.height, input_dims.width, input_dims.channels, output_dims.height,
+                                     output_dims.width, output_dims.channels, static_cast<std::int32_t>(output_type));
+    const auto it = cache_.find(key);
+    if (it != cache_.end())
+    {
+        return it->second.get();
+    }
+
+    if (cache_.size() >= kMaxCachedShapes)
+    {
+        cache_.clear();
+    }
+
+    auto resizer = std::make_unique<BilinearResizer>(input_dims.height, input_dims.width, input_dims.channels,
+                                                     output_dims.height, output_dims.width, output_dims.channels);
+    auto resizer_ptr = resizer.get();
+    cache_.emplace(key, std::move(resizer));
+    return resizer_ptr;
+}
+
+template <typename T>
+const T* PreprocessingEngine::GetQuantizationTable(const TfLiteQuantizationParams& params,
+                                                   QuantizationTable<T>* table) const
+{
+    if (!table->valid || (table->scale != params.scale) || (table->zero_point != params.zero_point))
+    {
+        CreateQuantizationTable(input_mean_, input_std_, params.scale, params.zero_point, table->values.data());
+        table->scale = params.scale;
+        table->zero_point = params.zero_point;
+        table->valid = true;
+    }
+    return table->values.data();
+}
+
+}  // namespace perception
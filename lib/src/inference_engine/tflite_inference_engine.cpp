@@ -2,11 +2,12 @@
 /// @file tflite_inference_engine.cpp
 /// @copyright Copyright (c) 2020. All Rights Reserved.
 ///
-#include <sys/time.h>
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <string>
 
 #include <experimental/filesystem>
@@ -17,24 +18,35 @@
 #include "tensorflow/lite/core/api/profiler.h"
 #include "tensorflow/lite/delegates/nnapi/nnapi_delegate.h"
 #include "tensorflow/lite/interpreter.h"
-#include "tensorflow/lite/kernels/register.h"
 #include "tensorflow/lite/optional_debug_tools.h"
 #include "tensorflow/lite/profiling/profile_summarizer.h"
 #include "tensorflow/lite/string_util.h"
 #include "tensorflow/lite/tools/evaluation/utils.h"
+#include "tensorflow/lite/version.h"
 #define TFLITE_PROFILING_ENABLED
 #include "tensorflow/lite/profiling/profiler.h"
 
+#include "perception/inference_engine/batch_classifier.h"
+#include "perception/inference_engine/batch_result_writer.h"
+#include "perception/inference_engine/delegate_registry.h"
+#include "perception/inference_engine/interpreter_pool.h"
+#include "perception/inference_engine/pipeline_executor.h"
 #include "perception/inference_engine/tflite_inference_engine.h"
+#include "perception/inference_engine/top_results.h"
 #include "perception/logging/logging.h"
-#include "perception/utils/get_top_n.h"
+#include "perception/op_resolver/op_resolver.h"
+#include "perception/utils/json.h"
+#include "perception/utils/latency_statistics.h"
 
 namespace perception
 {
 namespace
 {
-/// @brief Convert to usec (microseconds)
-constexpr double get_us(struct timeval t) { return (t.tv_sec * 1000000 + t.tv_usec); }
+/// @brief Elapsed time since given start (ms)
+double GetElapsedTime(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
 
 inline std::ostream& operator<<(std::ostream& os, const TfLiteIntArray* v)
 {
@@ -94,71 +106,17 @@ inline std::ostream& operator<<(std::ostream& os, const TfLiteType& type)
     return os;
 }
 
-/// @brief Resize Provided Image using TFLite Interpreter
-template <class T>
-void ResizeImage(T* out, const std::uint8_t* in, const std::int32_t image_height, const std::int32_t image_width,
-                 const std::int32_t image_channels, const std::int32_t wanted_height, const std::int32_t wanted_width,
-                 const std::int32_t wanted_channels, const bool input_floating, const float input_mean,
-                 const float input_std)
-{
-    std::int32_t number_of_pixels = image_height * image_width * image_channels;
-    std::unique_ptr<tflite::Interpreter> interpreter = std::make_unique<tflite::Interpreter>();
-
-    std::int32_t base_index = 0;
-
-    // two inputs: input and new_sizes
-    interpreter->AddTensors(2, &base_index);
-    // one output
-    interpreter->AddTensors(1, &base_index);
-    // set input and output tensors
-    interpreter->SetInputs({0, 1});
-    interpreter->SetOutputs({2});
-
-    // set parameters of tensors
-    TfLiteQuantizationParams quant;
-    interpreter->SetTensorParametersReadWrite(0, kTfLiteFloat32, "input",
-                                              {1, image_height, image_width, image_channels}, quant);
-    interpreter->SetTensorParametersReadWrite(1, kTfLiteInt32, "new_size", {2}, quant);
-    interpreter->SetTensorParametersReadWrite(2, kTfLiteFloat32, "output",
-                                              {1, wanted_height, wanted_width, wanted_channels}, quant);
-
-    tflite::ops::builtin::BuiltinOpResolver resolver;
-    const TfLiteRegistration* resize_op = resolver.FindOp(tflite::BuiltinOperator_RESIZE_BILINEAR, 1);
-    auto* params = reinterpret_cast<TfLiteResizeBilinearParams*>(malloc(sizeof(TfLiteResizeBilinearParams)));
-    params->align_corners = false;
-    interpreter->AddNodeWithParameters({0, 1}, {2}, nullptr, 0, params, resize_op, nullptr);
-
-    interpreter->AllocateTensors();
-
-    // fill input image
-    // in[] are integers, cannot do memcpy() directly
-    auto input = interpreter->typed_tensor<float>(0);
-    for (std::int32_t i = 0; i < number_of_pixels; i++)
-    {
-        input[i] = in[i];
-    }
-
-    // fill new_sizes
-    interpreter->typed_tensor<std::int32_t>(1)[0] = wanted_height;
-    interpreter->typed_tensor<std::int32_t>(1)[1] = wanted_width;
+/// @brief Maximum number of distinct batch sizes kept in the cache. (Cache is flushed once exceeded)
+constexpr std::size_t kMaxCachedBatchSizes = 4U;
 
-    interpreter->Invoke();
+/// @brief Capacity of each pipeline stage queue (frames)
+constexpr std::size_t kPipelineQueueCapacity = 4U;
 
-    auto output = interpreter->typed_tensor<float>(2);
-    auto output_number_of_pixels = wanted_height * wanted_width * wanted_channels;
+/// @brief Number of latency histogram buckets (benchmark mode)
+constexpr std::size_t kHistogramBuckets = 20U;
 
-    for (std::int32_t i = 0; i < output_number_of_pixels; i++)
-    {
-        if (input_floating)
-        {
-            out[i] = (output[i] - input_mean) / input_std;
-        }
-        else
-        {
-            out[i] = static_cast<std::uint8_t>(output[i]);
-        }
-    }
-}
+/// @brief Maximum number of results pending to be written (save results)
+constexpr std::size_t kResultQueueCapacity = 256U;
 
 /// @brief Write given content buffer to file
 void WriteToFile(const std::string& dirname, const std::string& filename, const std::string& content)
@@ -171,8 +129,16 @@ void WriteToFile(const std::string& dirname, const std::string& filename, const
 
 }  // namespace
 
-TFLiteInferenceEngine::TFLiteInferenceEngine() {}
-TFLiteInferenceEngine::TFLiteInferenceEngine(const CLIOptions& cli_options) : InferenceEngineBase{cli_options} {}
+TFLiteInferenceEngine::TFLiteInferenceEngine() : TFLiteInferenceEngine{CLIOptions{}} {}
+TFLiteInferenceEngine::TFLiteInferenceEngine(const CLIOptions& cli_options)
+    : InferenceEngineBase{cli_options},
+      delegate_{nullptr, [](TfLiteDelegate*) {}},
+      preprocessing_engine_{GetInputMean(), GetInputStd()},
+      input_cache_{GetInputCacheSize()},
+      result_writer_{},
+      frame_index_{0U}
+{
+}
 
 TFLiteInferenceEngine::~TFLiteInferenceEngine() {}
 
@@ -182,11 +148,21 @@ void TFLiteInferenceEngine::Init()
     ASSERT_CHECK(model_) << "Failed to mmap model " << GetModelPath();
     LOG(INFO) << "Loaded model \"" << GetModelPath() << "\"";
     model_->error_reporter();
+    LoadLabels();
 
-    tflite::ops::builtin::BuiltinOpResolver resolver;
+    if (IsBatchModeEnabled())
+    {
+        // batch mode classifies on an interpreter pool sharing model_ (see RunBatch()), i.e. without interpreter_
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    op_resolver_ = CreateOpResolver();
+    interpreter_ = BuildInterpreter();
+    LOG(INFO) << "Built interpreter in " << GetElapsedTime(start) << " ms";
+    batch_interpreters_.clear();
+    ApplyDelegate();
 
-    tflite::InterpreterBuilder(*model_, resolver)(&interpreter_);
-    ASSERT_CHECK(interpreter_) << "Failed to construct interpreter";
     if (IsVerbosityEnabled())
     {
         LOG(INFO) << "tensors size: " << interpreter_->tensors_size();
@@ -206,11 +182,6 @@ void TFLiteInferenceEngine::Init()
         }
     }
 
-    if (-1 != GetNumberOfThreads())
-    {
-        interpreter_->SetNumThreads(GetNumberOfThreads());
-    }
-
     if (IsVerbosityEnabled())
     {
         const auto inputs = interpreter_->inputs();
@@ -224,6 +195,18 @@ void TFLiteInferenceEngine::Init()
         LOG(FATAL) << "Failed to allocate tensors!";
     }
 
+    // decoding beyond model input size is wasted, as image gets downscaled anyway
+    const auto input_dims = interpreter_->tensor(interpreter_->inputs()[0])->dims;
+    SetImageMinimumSize(input_dims->data[2], input_dims->data[1]);
+    // same for chroma of single channel models, resizer would reduce color to luma anyway
+    SetImageLumaOnly(input_dims->data[3] == 1);
+
+    if (IsSaveResultsEnabled())
+    {
+        result_writer_ =
+            std::make_unique<AsyncResultWriter>(GetResultDirectory() + "/results.txt", kResultQueueCapacity);
+    }
+
     if (IsVerbosityEnabled())
     {
         PrintInterpreterState(interpreter_.get());
@@ -232,8 +215,35 @@ void TFLiteInferenceEngine::Init()
 
 void TFLiteInferenceEngine::Execute()
 {
-    SetInputData(GetImageData());
-    LOG(INFO) << "Loaded image \"" << GetImagePath() << "\"";
+    if (IsBatchModeEnabled())
+    {
+        RunBatch();
+        return;
+    }
+
+    if (IsBenchmarkEnabled())
+    {
+        RunBenchmark();
+        return;
+    }
+
+    if (IsPipelineEnabled())
+    {
+        RunPipeline();
+        return;
+    }
+
+    InputCacheKey input_cache_key{};
+    if (SetCachedInputData(&input_cache_key))
+    {
+        LOG(INFO) << "Loaded image \"" << GetImagePath() << "\" (from input cache)";
+    }
+    else
+    {
+        SetInputData(GetImageView());
+        CacheInputData(input_cache_key);
+        LOG(INFO) << "Loaded image \"" << GetImagePath() << "\"";
+    }
 
     auto profiler = absl::make_unique<tflite::profiling::Profiler>(GetMaxProfilingBufferEntries());
     interpreter_->SetProfiler(profiler.get());
@@ -256,114 +266,435 @@ void TFLiteInferenceEngine::Execute()
         LOG(INFO) << summary;
         if (IsSaveResultsEnabled())
         {
-            WriteToFile(GetResultDirectory(), "performance_metrics.txt", summary);
+            SaveResult("performance_metrics.txt", summary);
         }
     }
     const auto results = GetResults();
-    const auto labels = GetLabelList();
+    const auto& labels = GetLabels();
 
     std::stringstream content_stream;
     std::for_each(results.begin(), results.end(), [&](const auto& result) {
         const float confidence = result.first;
         const std::int32_t index = result.second;
-        content_stream << confidence << ": " << labels[index] << "\n";
+        content_stream << confidence << ": " << labels.Get(index) << "\n";
     });
     if (IsSaveResultsEnabled())
     {
-        WriteToFile(GetResultDirectory(), "top_k_results.txt", content_stream.str());
+        SaveResult("top_k_results.txt", content_stream.str());
     }
 
     LOG(INFO) << "Top " << GetNumberOfResults() << " Results: \n" << content_stream.str();
 
     if (IsSaveResultsEnabled())
     {
-        const auto intermediate_outputs = GetIntermediateOutput();
+        auto intermediate_outputs = GetIntermediateOutput();
         std::for_each(intermediate_outputs.begin(), intermediate_outputs.end(),
-                      [&](const auto& output) { WriteToFile(GetResultDirectory(), output.first, output.second); });
+                      [&](auto& output) { SaveResult(output.first, std::move(output.second)); });
+    }
+    ++frame_index_;
+}
+
+void TFLiteInferenceEngine::Shutdown()
+{
+    if (result_writer_)
+    {
+        result_writer_->Close();
+        LOG(INFO) << "Results written to " << GetResultDirectory() << "/results.txt ("
+                  << result_writer_->GetNumberOfRecords() << " records in " << result_writer_->GetNumberOfBatches()
+                  << " writes)";
+        result_writer_.reset();
+    }
+}
+
+std::vector<std::vector<std::pair<float, std::int32_t>>> TFLiteInferenceEngine::ExecuteBatch(
+    const std::vector<DecodedImage>& images)
+{
+    std::vector<std::vector<std::pair<float, std::int32_t>>> results;
+    if (images.empty())
+    {
+        return results;
+    }
+
+    const auto batch_size = static_cast<std::int32_t>(images.size());
+    auto interpreter = GetInterpreter(batch_size);
+    for (std::int32_t batch_index = 0; batch_index < batch_size; ++batch_index)
+    {
+        const auto& image = images[batch_index];
+        SetInputData(interpreter, batch_index, image.data.data(),
+                     ImageDimensions{image.height, image.width, image.channels});
+    }
+
+    const auto error_code = interpreter->Invoke();
+    ASSERT_CHECK_EQ(error_code, TfLiteStatus::kTfLiteOk) << "Failed to invoke tflite!";
+
+    results.reserve(images.size());
+    for (std::int32_t batch_index = 0; batch_index < batch_size; ++batch_index)
+    {
+        results.push_back(GetResults(interpreter, batch_index));
+    }
+    return results;
+}
+
+std::vector<std::vector<std::pair<float, std::int32_t>>> TFLiteInferenceEngine::ExecutePipeline(
+    const std::vector<std::string>& image_paths)
+{
+    PipelineExecutor executor{interpreter_.get(), GetInputMean(), GetInputStd(), GetNumberOfResults(),
+                              kPipelineQueueCapacity};
+    executor.SetNumberOfDecodeThreads(GetNumberOfDecodeThreads());
+    executor.SetRegionOfInterest(GetRegionOfInterest());
+    const auto pipeline_results = executor.Run(image_paths);
+
+    for (const auto& stage : executor.GetStageStatistics())
+    {
+        LOG(INFO) << "Stage " << stage.name << ": " << stage.frames << " frames, busy " << stage.busy_time_ms
+                  << " ms, occupancy " << stage.occupancy * 100.0 << "%, average queue size "
+                  << stage.average_queue_size;
+    }
+
+    std::vector<std::vector<std::pair<float, std::int32_t>>> results;
+    results.reserve(pipeline_results.size());
+    std::transform(pipeline_results.begin(), pipeline_results.end(), std::back_inserter(results),
+                   [](const auto& pipeline_result) { return pipeline_result.results; });
+    return results;
+}
+
+std::unique_ptr<tflite::Interpreter> TFLiteInferenceEngine::BuildInterpreter() const
+{
+    std::unique_ptr<tflite::Interpreter> interpreter;
+    tflite::InterpreterBuilder(*model_, *op_resolver_)(&interpreter);
+    ASSERT_CHECK(interpreter) << "Failed to construct interpreter";
+
+    if (-1 != GetNumberOfThreads())
+    {
+        interpreter->SetNumThreads(GetNumberOfThreads());
+    }
+    return interpreter;
+}
+
+void TFLiteInferenceEngine::ApplyDelegate()
+{
+    const auto delegate_name = GetDelegateName();
+    if (delegate_name == DelegateRegistry::kNoDelegate)
+    {
+        return;
+    }
+
+    delegate_ = DelegateRegistry::GetInstance().Create(delegate_name);
+    if (!delegate_)
+    {
+        LOG(WARN) << "Delegate {" << delegate_name << "} is not available, falling back to builtin kernels";
+        return;
     }
+
+    const auto number_of_nodes = interpreter_->execution_plan().size();
+    if (interpreter_->ModifyGraphWithDelegate(delegate_.get()) != TfLiteStatus::kTfLiteOk)
+    {
+        LOG(WARN) << "Delegate {" << delegate_name << "} failed to prepare graph, falling back to builtin kernels";
+        // graph may be left partially modified, start over with a fresh interpreter
+        interpreter_ = BuildInterpreter();
+        delegate_.reset();
+        return;
+    }
+
+    // each delegate kernel replaces a subset of the original nodes
+    std::size_t delegate_kernels = 0U;
+    for (const auto node_index : interpreter_->execution_plan())
+    {
+        if (interpreter_->node_and_registration(node_index)->first.delegate != nullptr)
+        {
+            ++delegate_kernels;
+        }
+    }
+    const auto builtin_nodes = interpreter_->execution_plan().size() - delegate_kernels;
+    LOG(INFO) << "Delegate {" << delegate_name << "} applied: " << number_of_nodes - builtin_nodes << " of "
+              << number_of_nodes << " nodes delegated (" << delegate_kernels << " delegate kernels)";
 }
 
-void TFLiteInferenceEngine::Shutdown() {}
+tflite::Interpreter* TFLiteInferenceEngine::GetInterpreter(const std::int32_t batch_size)
+{
+    ASSERT_CHECK(interpreter_) << "Interpreter is not built (batch mode classifies on an interpreter pool)";
+    if (batch_size == 1)
+    {
+        return interpreter_.get();
+    }
+
+    const auto it = batch_interpreters_.find(batch_size);
+    if (it != batch_interpreters_.end())
+    {
+        return it->second.get();
+    }
+
+    if (batch_interpreters_.size() >= kMaxCachedBatchSizes)
+    {
+        batch_interpreters_.clear();
+    }
+
+    auto interpreter = BuildInterpreter();
+    const auto input = interpreter->inputs()[0];
+    const TfLiteIntArray* dims = interpreter->tensor(input)->dims;
+    ASSERT_CHECK_EQ(dims->size, 4) << "Batching requires [N, H, W, C] model input";
+    const std::vector<std::int32_t> batch_dims{batch_size, dims->data[1], dims->data[2], dims->data[3]};
+    if ((interpreter->ResizeInputTensor(input, batch_dims) != TfLiteStatus::kTfLiteOk) ||
+        (interpreter->AllocateTensors() != TfLiteStatus::kTfLiteOk))
+    {
+        LOG(FATAL) << "Failed to allocate tensors for batch size " << batch_size << "!";
+    }
+
+    auto interpreter_ptr = interpreter.get();
+    batch_interpreters_.emplace(batch_size, std::move(interpreter));
+    return interpreter_ptr;
+}
 
 void TFLiteInferenceEngine::InvokeInference()
 {
-    struct timeval start_time;
-    struct timeval stop_time;
-    gettimeofday(&start_time, nullptr);
+    const auto start = std::chrono::steady_clock::now();
 
     auto error_code = interpreter_->Invoke();
     ASSERT_CHECK_EQ(error_code, TfLiteStatus::kTfLiteOk) << "Failed to invoke tflite!";
 
-    gettimeofday(&stop_time, nullptr);
-    auto avg_time_in_ms = (get_us(stop_time) - get_us(start_time)) / (GetLoopCount() * 1000);
-    auto images_per_sec = (1.0 / avg_time_in_ms) * 1000.0;
+    const auto time_in_ms = GetElapsedTime(start);
+    const auto images_per_sec = 1000.0 / time_in_ms;
 
-    LOG(INFO) << "Average time taken: " << avg_time_in_ms << " ms. (i.e. " << images_per_sec << " images/second) ";
+    LOG(INFO) << "Time taken: " << time_in_ms << " ms. (i.e. " << images_per_sec << " images/second) ";
 
     if (IsSaveResultsEnabled())
     {
-        WriteToFile(GetResultDirectory(), "images_per_second.txt",
-                    "images_per_second: " + std::to_string(images_per_sec));
+        SaveResult("images_per_second.txt", "images_per_second: " + std::to_string(images_per_sec));
+    }
+}
+
+void TFLiteInferenceEngine::RunBenchmark()
+{
+    const std::vector<std::string> stage_names{"decode", "preprocess", "invoke", "postprocess", "total"};
+    std::vector<LatencyStatistics> stage_statistics(stage_names.size());
+
+    // negative iterations are warmup runs, i.e. not recorded
+    for (std::int32_t iteration = -GetWarmupRuns(); iteration < GetLoopCount(); ++iteration)
+    {
+        // cache hits are accounted to decode, leaving nothing to preprocess
+        const auto start = std::chrono::steady_clock::now();
+        InputCacheKey input_cache_key{};
+        const auto cached = SetCachedInputData(&input_cache_key);
+        const auto image_data = cached ? nullptr : GetImageView();
+        const auto decoded = std::chrono::steady_clock::now();
+        if (!cached)
+        {
+            SetInputData(image_data);
+            CacheInputData(input_cache_key);
+        }
+        const auto preprocessed = std::chrono::steady_clock::now();
+        ASSERT_CHECK_EQ(interpreter_->Invoke(), TfLiteStatus::kTfLiteOk) << "Failed to invoke tflite!";
+        const auto invoked = std::chrono::steady_clock::now();
+        const auto results = GetResults();
+        const auto postprocessed = std::chrono::steady_clock::now();
+
+        if (iteration >= 0)
+        {
+            const std::vector<std::chrono::steady_clock::time_point> timestamps{start, decoded, preprocessed,
+                                                                                invoked, postprocessed};
+            for (std::size_t stage = 0U; stage + 1U < timestamps.size(); ++stage)
+            {
+                stage_statistics[stage].Add(
+                    std::chrono::duration<double, std::milli>(timestamps[stage + 1U] - timestamps[stage]).count());
+            }
+            stage_statistics.back().Add(std::chrono::duration<double, std::milli>(postprocessed - start).count());
+        }
+    }
+
+    std::stringstream json;
+    json << "{\n  \"model\": ";
+    WriteJsonString(json, GetModelPath());
+    json << ",\n  \"image\": ";
+    WriteJsonString(json, GetImagePath());
+    json << ",\n  \"tflite_version\": \"" << TFLITE_VERSION_STRING << "\",\n  \"threads\": " << GetNumberOfThreads()
+         << ",\n  \"input_cache_hits\": " << input_cache_.GetNumberOfHits()
+         << ",\n  \"warmup_runs\": " << GetWarmupRuns()
+         << ",\n  \"iterations\": " << GetLoopCount() << ",\n  \"stages\": {";
+    for (std::size_t stage = 0U; stage < stage_names.size(); ++stage)
+    {
+        const auto& statistics = stage_statistics[stage];
+        LOG(INFO) << "Benchmark " << stage_names[stage] << ": min " << statistics.GetMin() << " ms, mean "
+                  << statistics.GetMean() << " ms, p50 " << statistics.GetPercentile(50.0) << " ms, p90 "
+                  << statistics.GetPercentile(90.0) << " ms, p99 " << statistics.GetPercentile(99.0) << " ms, max "
+                  << statistics.GetMax() << " ms";
+        json << ((stage > 0U) ? "," : "") << "\n    \"" << stage_names[stage]
+             << "\": " << statistics.ToJson(kHistogramBuckets);
+    }
+    json << "\n  }\n}\n";
+
+    WriteToFile(GetResultDirectory(), "benchmark.json", json.str());
+    LOG(INFO) << "Benchmark results written to " << GetResultDirectory() << "/benchmark.json";
+}
+
+void TFLiteInferenceEngine::RunBatch()
+{
+    const auto image_paths = BatchClassifier::ListImages(GetBatchInput());
+    const auto number_of_workers = static_cast<std::size_t>(GetBatchWorkers());
+    LOG(INFO) << "Classifying " << image_paths.size() << " images from \"" << GetBatchInput() << "\" with "
+              << number_of_workers << " workers";
+
+    // one interpreter per worker, all of them sharing the model mapped by Init()
+    ASSERT_CHECK(model_) << "Model is not loaded (batch mode requires Init())";
+    InterpreterPool pool{*model_, number_of_workers, GetNumberOfThreads()};
+    BatchClassifier classifier{&pool, GetInputMean(), GetInputStd(), GetNumberOfResults(), number_of_workers};
+    const auto output_path = GetResultDirectory() + "/" + GetBatchOutput();
+    BatchResultWriter writer{output_path, GetLabels()};
+    const auto statistics = classifier.Run(image_paths, [&writer](const BatchResult& result) {
+        if (!result.error.empty())
+        {
+            LOG(WARN) << "Failed to classify " << result.image_path << ": " << result.error;
+        }
+        writer.Write(result);
+    });
+
+    const auto& latency = statistics.latency;
+    LOG(INFO) << "Batch: " << statistics.images << " images (" << statistics.failures << " failed) in "
+              << statistics.wall_time_ms << " ms, i.e. " << statistics.images_per_second << " images/second";
+    LOG(INFO) << "Batch latency per image: min " << latency.GetMin() << " ms, mean " << latency.GetMean()
+              << " ms, p50 " << latency.GetPercentile(50.0) << " ms, p90 " << latency.GetPercentile(90.0)
+              << " ms, p99 " << latency.GetPercentile(99.0) << " ms, max " << latency.GetMax() << " ms";
+
+    std::stringstream json;
+    json << "{\n  \"model\": ";
+    WriteJsonString(json, GetModelPath());
+    json << ",\n  \"input\": ";
+    WriteJsonString(json, GetBatchInput());
+    json << ",\n  \"workers\": " << number_of_workers << ",\n  \"threads\": " << GetNumberOfThreads()
+         << ",\n  \"images\": " << statistics.images << ",\n  \"failures\": " << statistics.failures
+         << ",\n  \"wall_time_ms\": " << statistics.wall_time_ms
+         << ",\n  \"images_per_second\": " << statistics.images_per_second
+         << ",\n  \"latency\": " << latency.ToJson(kHistogramBuckets) << "\n}\n";
+    WriteToFile(GetResultDirectory(), "batch_statistics.json", json.str());
+    LOG(INFO) << "Batch results written to " << output_path;
+}
+
+void TFLiteInferenceEngine::RunPipeline()
+{
+    // input image is streamed loop_count times, i.e. decode/preprocess of frame N+1 overlaps with invoke of frame N
+    const std::vector<std::string> image_paths(static_cast<std::size_t>(std::max(GetLoopCount(), 1)), GetImagePath());
+    LOG(INFO) << "Streaming " << image_paths.size() << " frames of \"" << GetImagePath() << "\" through pipeline";
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto results = ExecutePipeline(image_paths);
+    const auto wall_time_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LOG(INFO) << "Pipeline: " << results.size() << " frames in " << wall_time_ms << " ms, i.e. "
+              << ((wall_time_ms > 0.0) ? (results.size() * 1000.0 / wall_time_ms) : 0.0) << " frames/second";
+
+    const auto& labels = GetLabels();
+    std::string content;
+    for (const auto& frame_results : results)
+    {
+        std::stringstream content_stream;
+        std::for_each(frame_results.begin(), frame_results.end(), [&](const auto& result) {
+            content_stream << result.first << ": " << labels.Get(result.second) << "\n";
+        });
+        content = content_stream.str();
+        if (IsSaveResultsEnabled())
+        {
+            SaveResult("top_k_results.txt", content);
+        }
+        ++frame_index_;
     }
+
+    LOG(INFO) << "Top " << GetNumberOfResults() << " Results (last frame): \n" << content;
+}
+
+void TFLiteInferenceEngine::SaveResult(const std::string& name, std::string content)
+{
+    ASSERT_CHECK(result_writer_) << "Results file is not open (save results requires Init())";
+    result_writer_->Submit("frame " + std::to_string(frame_index_) + ": " + name, std::move(content));
 }
 
-void TFLiteInferenceEngine::SetInputData(const std::vector<std::uint8_t>& image_data)
+void TFLiteInferenceEngine::SetInputData(const std::uint8_t* image_data)
 {
-    const auto input = interpreter_->inputs()[0];
+    SetInputData(interpreter_.get(), 0, image_data,
+                 ImageDimensions{GetImageHeight(), GetImageWidth(), GetImageChannels()});
+}
+
+bool TFLiteInferenceEngine::SetCachedInputData(InputCacheKey* key)
+{
+    if (!input_cache_.IsEnabled())
+    {
+        return false;
+    }
+
+    const auto input = interpreter_->tensor(interpreter_->inputs()[0]);
+    *key = InputCache::MakeKey(GetImagePath(), std::vector<std::int32_t>(input->dims->data,
+                                                                         input->dims->data + input->dims->size),
+                               static_cast<std::int32_t>(input->type));
+    const auto cached = input_cache_.Find(*key);
+    if (!cached || (cached->size() != input->bytes))
+    {
+        return false;
+    }
+    std::copy(cached->begin(), cached->end(), reinterpret_cast<std::uint8_t*>(input->data.raw));
+    return true;
+}
+
+void TFLiteInferenceEngine::CacheInputData(const InputCacheKey& key)
+{
+    if (!input_cache_.IsEnabled())
+    {
+        return;
+    }
+
+    const auto input = interpreter_->tensor(interpreter_->inputs()[0]);
+    input_cache_.Insert(key, reinterpret_cast<const std::uint8_t*>(input->data.raw), input->bytes);
+}
+
+void TFLiteInferenceEngine::SetInputData(tflite::Interpreter* interpreter, const std::int32_t batch_index,
+                                         const std::uint8_t* image_data, const ImageDimensions& image_dims)
+{
+    const auto input = interpreter->inputs()[0];
 
     // get input dimension from the input tensor metadata
     // assuming one input only
-    TfLiteIntArray* dims = interpreter_->tensor(input)->dims;
-    std::int32_t wanted_height = dims->data[1];
-    std::int32_t wanted_width = dims->data[2];
-    std::int32_t wanted_channels = dims->data[3];
+    TfLiteIntArray* dims = interpreter->tensor(input)->dims;
+    const ImageDimensions wanted_dims{dims->data[1], dims->data[2], dims->data[3]};
+    const TfLiteQuantizationParams& params = interpreter->tensor(input)->params;
+    const auto offset = batch_index * wanted_dims.height * wanted_dims.width * wanted_dims.channels;
 
-    switch (interpreter_->tensor(input)->type)
+    switch (interpreter->tensor(input)->type)
     {
         case TfLiteType::kTfLiteFloat32:
-            ResizeImage<float>(interpreter_->typed_tensor<float>(input), image_data.data(), GetImageHeight(),
-                               GetImageWidth(), GetImageChannels(), wanted_height, wanted_width, wanted_channels, true,
-                               GetInputMean(), GetInputStd());
+            preprocessing_engine_.Resize(image_data, image_dims, wanted_dims,
+                                         interpreter->typed_tensor<float>(input) + offset);
             break;
         case TfLiteType::kTfLiteUInt8:
-            ResizeImage<std::uint8_t>(interpreter_->typed_tensor<std::uint8_t>(input), image_data.data(),
-                                      GetImageHeight(), GetImageWidth(), GetImageChannels(), wanted_height,
-                                      wanted_width, wanted_channels, false, GetInputMean(), GetInputStd());
+            preprocessing_engine_.Resize(image_data, image_dims, wanted_dims, params,
+                                         interpreter->typed_tensor<std::uint8_t>(input) + offset);
+            break;
+        case TfLiteType::kTfLiteInt8:
+            preprocessing_engine_.Resize(image_data, image_dims, wanted_dims, params,
+                                         interpreter->typed_tensor<std::int8_t>(input) + offset);
             break;
         default:
-            throw std::runtime_error("cannot handle input type " + std::to_string(interpreter_->tensor(input)->type) +
+            throw std::runtime_error("cannot handle input type " + std::to_string(interpreter->tensor(input)->type) +
                                      " yet");
     }
 }
 
 std::vector<std::pair<float, std::int32_t>> TFLiteInferenceEngine::GetResults() const
 {
-    std::vector<std::pair<float, std::int32_t>> top_results;
-    const float threshold = 0.001f;
+    ASSERT_CHECK(interpreter_) << "No results, interpreter is not built (batch mode writes them to batch output)";
+    return GetResults(interpreter_.get(), 0);
+}
 
-    const auto output = interpreter_->outputs()[0];
-    const auto output_dims = interpreter_->tensor(output)->dims;
-    // assume output dims to be something like (1, 1, ... ,size)
-    const auto output_size = output_dims->data[output_dims->size - 1];
-    switch (interpreter_->tensor(output)->type)
-    {
-        case TfLiteType::kTfLiteFloat32:
-            get_top_n<float>(interpreter_->typed_output_tensor<float>(0), output_size, GetNumberOfResults(), threshold,
-                             &top_results, true);
-            break;
-        case TfLiteType::kTfLiteUInt8:
-            get_top_n<std::uint8_t>(interpreter_->typed_output_tensor<std::uint8_t>(0), output_size,
-                                    GetNumberOfResults(), threshold, &top_results, false);
-            break;
-        default:
-            throw std::runtime_error("cannot handle output type " + std::to_string(interpreter_->tensor(output)->type) +
-                                     " yet");
-    }
-    return top_results;
+std::vector<std::pair<float, std::int32_t>> TFLiteInferenceEngine::GetResults(tflite::Interpreter* interpreter,
+                                                                             const std::int32_t batch_index) const
+{
+    const auto output = interpreter->tensor(interpreter->outputs()[0]);
+    // assume output dims to be something like (N, 1, ... ,size)
+    const auto output_size = output->dims->data[output->dims->size - 1];
+    const auto batch_slot_bytes = output->bytes / output->dims->data[0];
+    return GetTopResults(output->type, output->params, output->data.raw_const + batch_index * batch_slot_bytes,
+                         output_size, GetNumberOfResults());
 }
 
 std::vector<std::pair<std::string, std::string>> TFLiteInferenceEngine::GetIntermediateOutput() const
 {
+    ASSERT_CHECK(interpreter_) << "No intermediate outputs, interpreter is not built";
     std::vector<std::pair<std::string, std::string>> intermediate_outputs;
     for (std::size_t tensor_index = 0; tensor_index < interpreter_->tensors_size() - 1; tensor_index++)
     {
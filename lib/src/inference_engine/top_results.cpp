@@ -0,0 +1,40 @@
+///
+/// @file top_results.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "perception/inference_engine/top_results.h"
+#include "perception/utils/top_k.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief Minimum confidence to be reported
+constexpr float kThreshold = 0.001F;
+}  // namespace
+
+std::vector<std::pair<float, std::int32_t>> GetTopResults(const TfLiteType type, const TfLiteQuantizationParams& params,
+                                                          const void* data, const std::int32_t size,
+                                                          const std::int32_t number_of_results)
+{
+    const auto k = static_cast<std::size_t>(std::max(number_of_results, 0));
+    switch (type)
+    {
+        case TfLiteType::kTfLiteFloat32:
+            return GetTopK(static_cast<const float*>(data), size, k, kThreshold);
+        case TfLiteType::kTfLiteUInt8:
+            return GetTopK(static_cast<const std::uint8_t*>(data), size, k, kThreshold, params.scale,
+                           params.zero_point);
+        case TfLiteType::kTfLiteInt8:
+            return GetTopK(static_cast<const std::int8_t*>(data), size, k, kThreshold, params.scale,
+                           params.zero_point);
+        default:
+            throw std::runtime_error("cannot handle output type " + std::to_string(type) + " yet");
+    }
+}
+
+}  // namespace perception
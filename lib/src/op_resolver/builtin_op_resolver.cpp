@@ -0,0 +1,16 @@
+///
+/// @file builtin_op_resolver.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "tensorflow/lite/kernels/register.h"
+
+#include "perception/op_resolver/op_resolver.h"
+
+namespace perception
+{
+std::unique_ptr<tflite::OpResolver> CreateOpResolver()
+{
+    return std::make_unique<tflite::ops::builtin::BuiltinOpResolver>();
+}
+
+}  // namespace perception
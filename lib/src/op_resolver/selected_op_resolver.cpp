@@ -0,0 +1,21 @@
+///
+/// @file selected_op_resolver.cpp
+/// @brief Op Resolver with only the ops used by a model. Compiled along with the registration generated by
+///        tflite_op_resolver() (see bazel/rules/op_resolver.bzl).
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "perception/op_resolver/op_resolver.h"
+
+/// @brief Registers ops used by the model (generated by //tensorflow/lite/tools:generate_op_registrations)
+void RegisterSelectedOps(::tflite::MutableOpResolver* resolver);
+
+namespace perception
+{
+std::unique_ptr<tflite::OpResolver> CreateOpResolver()
+{
+    auto resolver = std::make_unique<tflite::MutableOpResolver>();
+    RegisterSelectedOps(resolver.get());
+    return resolver;
+}
+
+}  // namespace perception
@@ -35,7 +35,12 @@ void Perception::Init() { inference_engine_->Init(); }
 
 void Perception::Execute()
 {
-    for (auto iter = 0; iter < argument_parser_->GetParsedArgs().loop_count; ++iter)
+    // benchmark and pipeline modes iterate (resp. stream the frames) within the inference engine, batch mode classifies
+    // the whole set once (each pass would truncate the batch results)
+    const auto cli_options = argument_parser_->GetParsedArgs();
+    const auto single_pass = cli_options.benchmark || cli_options.pipeline || !cli_options.batch_input.empty();
+    const auto loop_count = single_pass ? 1 : cli_options.loop_count;
+    for (auto iter = 0; iter < loop_count; ++iter)
     {
         inference_engine_->Execute();
     }
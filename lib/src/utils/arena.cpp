@@ -0,0 +1,85 @@
+///
+/// @file arena.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <cstdlib>
+
+#include "perception/utils/arena.h"
+
+namespace perception
+{
+namespace
+{
+constexpr std::size_t AlignUp(const std::size_t size)
+{
+    return (size + Arena::kAlignment - 1U) & ~(Arena::kAlignment - 1U);
+}
+}  // namespace
+
+constexpr std::size_t Arena::kAlignment;
+
+Arena::Arena(const std::size_t capacity)
+    : block_memory_{nullptr},
+      block_{nullptr},
+      capacity_{0U},
+      used_{AlignUp(capacity)},
+      mutex_{},
+      fallbacks_{},
+      heap_allocations_{0U}
+{
+    Reset();
+}
+
+Arena::~Arena()
+{
+    Reset();
+    std::free(block_memory_);
+}
+
+void* Arena::Allocate(const std::size_t size)
+{
+    const auto aligned_size = AlignUp(size);
+    const auto offset = used_.fetch_add(aligned_size);
+    if ((offset + aligned_size) <= capacity_)
+    {
+        return &block_[offset];
+    }
+
+    void* fallback = std::malloc(aligned_size + kAlignment);
+    if (!fallback)
+    {
+        return nullptr;
+    }
+    ++heap_allocations_;
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        fallbacks_.push_back(fallback);
+    }
+    return reinterpret_cast<void*>(AlignUp(reinterpret_cast<std::uintptr_t>(fallback)));
+}
+
+void Arena::Reset()
+{
+    for (auto fallback : fallbacks_)
+    {
+        std::free(fallback);
+    }
+    fallbacks_.clear();
+
+    const auto used = used_.exchange(0U);
+    if (used > capacity_)
+    {
+        std::free(block_memory_);
+        block_memory_ = static_cast<std::uint8_t*>(std::malloc(used + kAlignment));
+        ++heap_allocations_;
+        const auto address = reinterpret_cast<std::uintptr_t>(block_memory_);
+        block_ = block_memory_ ? reinterpret_cast<std::uint8_t*>(AlignUp(address)) : nullptr;
+        capacity_ = block_memory_ ? used : 0U;
+    }
+}
+
+std::size_t Arena::GetCapacity() const { return capacity_; }
+
+std::size_t Arena::GetNumberOfHeapAllocations() const { return heap_allocations_; }
+
+}  // namespace perception
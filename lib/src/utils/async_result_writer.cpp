@@ -0,0 +1,156 @@
+///
+/// @file async_result_writer.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <stdexcept>
+#include <utility>
+
+#include "perception/utils/async_result_writer.h"
+
+namespace perception
+{
+AsyncResultWriter::AsyncResultWriter(const std::string& path, const std::size_t queue_capacity)
+    : path_{path},
+      file_{path, std::ios::out | std::ios::binary | std::ios::trunc},
+      queue_{queue_capacity},
+      mutex_{},
+      records_submitted_{},
+      records_written_{},
+      submitted_{0U},
+      written_{0U},
+      batches_{0U},
+      error_{},
+      failed_{false},
+      writer_{}
+{
+    if (!file_.is_open())
+    {
+        throw std::runtime_error("Unable to open " + path_);
+    }
+    writer_ = std::thread{[this]() { Work(); }};
+}
+
+AsyncResultWriter::~AsyncResultWriter()
+{
+    try
+    {
+        Close();
+    }
+    catch (...)
+    {
+        // destructor must not throw, failure was reported to Flush()/Close() callers (if any)
+    }
+}
+
+void AsyncResultWriter::Submit(const std::string& name, std::string content)
+{
+    CheckError();
+    if (queue_.IsClosed() || !queue_.Push(Record{name, std::move(content)}))
+    {
+        CheckError();
+        throw std::runtime_error("Result writer of " + path_ + " is closed");
+    }
+    {
+        // record is pushed before the lock is taken, thus writer thread either sees it or already waits
+        std::lock_guard<std::mutex> lock{mutex_};
+        ++submitted_;
+    }
+    records_submitted_.notify_one();
+}
+
+void AsyncResultWriter::Flush()
+{
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        records_written_.wait(lock, [this]() {
+            return failed_.load(std::memory_order_acquire) || (written_.load(std::memory_order_acquire) >= submitted_);
+        });
+    }
+    CheckError();
+}
+
+void AsyncResultWriter::Close()
+{
+    if (writer_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            queue_.Close();
+        }
+        records_submitted_.notify_one();
+        writer_.join();
+        file_.close();
+    }
+    CheckError();
+}
+
+std::size_t AsyncResultWriter::GetNumberOfRecords() const { return written_.load(std::memory_order_acquire); }
+
+std::size_t AsyncResultWriter::GetNumberOfBatches() const { return batches_.load(std::memory_order_acquire); }
+
+void AsyncResultWriter::Work()
+{
+    std::string batch;
+    Record record{};
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            records_submitted_.wait(lock, [this]() { return (queue_.GetSize() > 0U) || queue_.IsClosed(); });
+        }
+
+        // records pushed before Close() are visible once it is observed, i.e. drained below
+        const auto closed = queue_.IsClosed();
+        std::size_t count = 0U;
+        batch.clear();
+        while (queue_.TryPop(&record))
+        {
+            batch.append("### ").append(record.name).append("\n").append(record.content);
+            if (record.content.empty() || (record.content.back() != '\n'))
+            {
+                batch.push_back('\n');
+            }
+            ++count;
+        }
+
+        if (count == 0U)
+        {
+            if (closed)
+            {
+                return;
+            }
+            continue;
+        }
+
+        file_.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        file_.flush();
+        if (!file_)
+        {
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                error_ = std::make_exception_ptr(std::runtime_error("Failed to write " + path_));
+                failed_.store(true, std::memory_order_release);
+                // unblocks submitting thread, if it waits for space
+                queue_.Close();
+            }
+            records_written_.notify_all();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            written_.fetch_add(count, std::memory_order_release);
+            batches_.fetch_add(1U, std::memory_order_release);
+        }
+        records_written_.notify_all();
+    }
+}
+
+void AsyncResultWriter::CheckError() const
+{
+    if (failed_.load(std::memory_order_acquire))
+    {
+        std::rethrow_exception(error_);
+    }
+}
+
+}  // namespace perception
@@ -0,0 +1,113 @@
+///
+/// @file input_cache.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <experimental/filesystem>
+#include <functional>
+
+#include "perception/utils/input_cache.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief Combines hash of value into seed (boost::hash_combine)
+template <typename T>
+void HashCombine(std::size_t* seed, const T& value)
+{
+    *seed ^= std::hash<T>{}(value) + 0x9E3779B9U + (*seed << 6U) + (*seed >> 2U);
+}
+}  // namespace
+
+bool InputCacheKey::operator==(const InputCacheKey& other) const
+{
+    return (path == other.path) && (modification_time == other.modification_time) &&
+           (file_size == other.file_size) && (shape == other.shape) && (type == other.type);
+}
+
+std::size_t InputCacheKeyHash::operator()(const InputCacheKey& key) const
+{
+    std::size_t seed = std::hash<std::string>{}(key.path);
+    HashCombine(&seed, key.modification_time);
+    HashCombine(&seed, key.file_size);
+    for (const auto dim : key.shape)
+    {
+        HashCombine(&seed, dim);
+    }
+    HashCombine(&seed, key.type);
+    return seed;
+}
+
+InputCache::InputCache(const std::size_t capacity)
+    : capacity_{capacity}, size_{0U}, entries_{}, index_{}, hits_{0U}, misses_{0U}
+{
+}
+
+InputCacheKey InputCache::MakeKey(const std::string& path, const std::vector<std::int32_t>& shape,
+                                  const std::int32_t type)
+{
+    namespace fs = std::experimental::filesystem;
+    InputCacheKey key{};
+    key.path = path;
+    key.modification_time = static_cast<std::int64_t>(fs::last_write_time(path).time_since_epoch().count());
+    key.file_size = static_cast<std::uint64_t>(fs::file_size(path));
+    key.shape = shape;
+    key.type = type;
+    return key;
+}
+
+bool InputCache::IsEnabled() const { return capacity_ > 0U; }
+
+const std::vector<std::uint8_t>* InputCache::Find(const InputCacheKey& key)
+{
+    const auto it = index_.find(key);
+    if (it == index_.end())
+    {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return &it->second->second;
+}
+
+void InputCache::Insert(const InputCacheKey& key, const std::uint8_t* data, const std::size_t size)
+{
+    if (size > capacity_)
+    {
+        return;
+    }
+
+    const auto it = index_.find(key);
+    if (it != index_.end())
+    {
+        size_ -= it->second->second.size();
+        entries_.erase(it->second);
+        index_.erase(it);
+    }
+    Evict(size);
+
+    entries_.emplace_front(key, std::vector<std::uint8_t>(data, data + size));
+    index_.emplace(key, entries_.begin());
+    size_ += size;
+}
+
+void InputCache::Evict(const std::size_t size)
+{
+    while (!entries_.empty() && ((size_ + size) > capacity_))
+    {
+        size_ -= entries_.back().second.size();
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+}
+
+std::size_t InputCache::GetSize() const { return size_; }
+
+std::size_t InputCache::GetNumberOfEntries() const { return entries_.size(); }
+
+std::size_t InputCache::GetNumberOfHits() const { return hits_; }
+
+std::size_t InputCache::GetNumberOfMisses() const { return misses_; }
+
+}  // namespace perception
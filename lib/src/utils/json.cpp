@@ -0,0 +1,50 @@
+///
+/// @file json.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <cstdio>
+
+#include "perception/utils/json.h"
+
+namespace perception
+{
+void WriteJsonString(std::ostream& stream, const absl::string_view value)
+{
+    stream << '"';
+    for (const char c : value)
+    {
+        switch (c)
+        {
+            case '"':
+                stream << "\\\"";
+                break;
+            case '\\':
+                stream << "\\\\";
+                break;
+            case '\n':
+                stream << "\\n";
+                break;
+            case '\r':
+                stream << "\\r";
+                break;
+            case '\t':
+                stream << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20U)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    stream << escaped;
+                }
+                else
+                {
+                    stream << c;
+                }
+                break;
+        }
+    }
+    stream << '"';
+}
+
+}  // namespace perception
@@ -0,0 +1,118 @@
+///
+/// @file label_table.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "perception/utils/label_table.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief Size of binary file header, i.e. magic number and number of labels
+constexpr std::size_t kHeaderSize = 8U;
+}  // namespace
+
+constexpr char LabelTable::kMagic[4];
+
+LabelTable::LabelTable() : arena_{}, offsets_{0U}, mapping_{}, size_{0U} {}
+
+LabelTable LabelTable::Load(const std::string& path)
+{
+    auto file = std::make_unique<MappedFile>(path);
+    const auto data = file->GetData();
+    const auto file_size = file->GetSize();
+
+    LabelTable table;
+    if ((file_size >= kHeaderSize) && (std::memcmp(data, kMagic, sizeof(kMagic)) == 0))
+    {
+        // binary, i.e. used in place (mapping is page aligned, thus offsets are aligned too)
+        std::uint32_t size = 0U;
+        std::memcpy(&size, &data[sizeof(kMagic)], sizeof(size));
+        const auto offsets = reinterpret_cast<const std::uint32_t*>(&data[kHeaderSize]);
+        const auto number_of_offsets = (file_size - kHeaderSize) / sizeof(std::uint32_t);
+        bool valid = (size < number_of_offsets) && (offsets[0] == 0U);
+        if (valid)
+        {
+            const auto characters_begin = kHeaderSize + (static_cast<std::size_t>(size) + 1U) * sizeof(std::uint32_t);
+            valid = (offsets[size] <= (file_size - characters_begin));
+        }
+        for (std::uint32_t index = 0U; valid && (index < size); ++index)
+        {
+            valid = (offsets[index] <= offsets[index + 1U]);
+        }
+        if (!valid)
+        {
+            throw std::runtime_error("Label file " + path + " is malformed");
+        }
+        table.size_ = size;
+        table.mapping_ = std::move(file);
+        return table;
+    }
+
+    // text, one label per line (w/o line break, same as std::getline)
+    table.arena_.reserve(file_size);
+    table.offsets_.clear();
+    table.offsets_.push_back(0U);
+    std::size_t begin = 0U;
+    while (begin < file_size)
+    {
+        const auto line_break = static_cast<const std::uint8_t*>(std::memchr(&data[begin], '\n', file_size - begin));
+        const std::size_t end = line_break ? static_cast<std::size_t>(line_break - data) : file_size;
+        table.arena_.append(reinterpret_cast<const char*>(&data[begin]), end - begin);
+        table.offsets_.push_back(static_cast<std::uint32_t>(table.arena_.size()));
+        begin = end + 1U;
+    }
+    table.size_ = table.offsets_.size() - 1U;
+    return table;
+}
+
+void LabelTable::Save(const std::string& path) const
+{
+    std::ofstream file{path, std::ios::out | std::ios::binary | std::ios::trunc};
+    const auto size = static_cast<std::uint32_t>(size_);
+    const auto offsets = GetOffsets();
+    file.write(kMagic, sizeof(kMagic));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(offsets), (size_ + 1U) * sizeof(std::uint32_t));
+    file.write(GetCharacters(), offsets[size_]);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write label file " + path);
+    }
+}
+
+absl::string_view LabelTable::Get(const std::size_t index) const
+{
+    if (index >= size_)
+    {
+        return absl::string_view{};
+    }
+    const auto offsets = GetOffsets();
+    return absl::string_view{&GetCharacters()[offsets[index]], offsets[index + 1U] - offsets[index]};
+}
+
+std::size_t LabelTable::GetSize() const { return size_; }
+
+const char* LabelTable::GetCharacters() const
+{
+    if (mapping_)
+    {
+        return reinterpret_cast<const char*>(&mapping_->GetData()[kHeaderSize + (size_ + 1U) * sizeof(std::uint32_t)]);
+    }
+    return arena_.data();
+}
+
+const std::uint32_t* LabelTable::GetOffsets() const
+{
+    if (mapping_)
+    {
+        return reinterpret_cast<const std::uint32_t*>(&mapping_->GetData()[kHeaderSize]);
+    }
+    return offsets_.data();
+}
+
+}  // namespace perception
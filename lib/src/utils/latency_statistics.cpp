@@ -0,0 +1,85 @@
+///
+/// @file latency_statistics.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "perception/utils/latency_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+
+namespace perception
+{
+LatencyStatistics::LatencyStatistics() : samples_{} {}
+
+void LatencyStatistics::Add(const double latency_ms) { samples_.push_back(latency_ms); }
+
+std::size_t LatencyStatistics::GetCount() const { return samples_.size(); }
+
+double LatencyStatistics::GetMin() const
+{
+    return samples_.empty() ? 0.0 : *std::min_element(samples_.begin(), samples_.end());
+}
+
+double LatencyStatistics::GetMean() const
+{
+    return samples_.empty() ? 0.0 : std::accumulate(samples_.begin(), samples_.end(), 0.0) / samples_.size();
+}
+
+double LatencyStatistics::GetMax() const
+{
+    return samples_.empty() ? 0.0 : *std::max_element(samples_.begin(), samples_.end());
+}
+
+double LatencyStatistics::GetPercentile(const double percentile) const
+{
+    if (samples_.empty())
+    {
+        return 0.0;
+    }
+    // nearest-rank, i.e. smallest sample such that at least percentile % of samples are less or equal to it
+    const auto rank = static_cast<std::size_t>(std::ceil(percentile / 100.0 * samples_.size()));
+    const auto index = std::min(std::max(rank, std::size_t{1U}), samples_.size()) - 1U;
+    auto sorted = samples_;
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+std::vector<std::size_t> LatencyStatistics::GetHistogram(const std::size_t number_of_buckets) const
+{
+    std::vector<std::size_t> histogram(number_of_buckets, 0U);
+    if (samples_.empty() || (number_of_buckets == 0U))
+    {
+        return histogram;
+    }
+
+    const auto min = GetMin();
+    const auto bucket_width = (GetMax() - min) / number_of_buckets;
+    for (const auto sample : samples_)
+    {
+        const auto bucket = (bucket_width > 0.0) ? static_cast<std::size_t>((sample - min) / bucket_width) : 0U;
+        // max latency falls onto upper edge of last bucket
+        ++histogram[std::min(bucket, number_of_buckets - 1U)];
+    }
+    return histogram;
+}
+
+std::string LatencyStatistics::ToJson(const std::size_t number_of_buckets) const
+{
+    std::ostringstream json;
+    json << "{\"count\": " << GetCount() << ", \"min_ms\": " << GetMin() << ", \"mean_ms\": " << GetMean()
+         << ", \"p50_ms\": " << GetPercentile(50.0) << ", \"p90_ms\": " << GetPercentile(90.0)
+         << ", \"p99_ms\": " << GetPercentile(99.0) << ", \"max_ms\": " << GetMax()
+         << ", \"histogram\": {\"bucket_width_ms\": "
+         << ((number_of_buckets > 0U) ? (GetMax() - GetMin()) / number_of_buckets : 0.0) << ", \"counts\": [";
+    const auto histogram = GetHistogram(number_of_buckets);
+    for (std::size_t bucket = 0U; bucket < histogram.size(); ++bucket)
+    {
+        json << ((bucket > 0U) ? ", " : "") << histogram[bucket];
+    }
+    json << "]}}";
+    return json.str();
+}
+
+}  // namespace perception
@@ -0,0 +1,84 @@
+///
+/// @file mapped_file.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+#include "perception/utils/mapped_file.h"
+
+namespace perception
+{
+MappedFile::MappedFile(const std::string& path) : data_{nullptr}, size_{0U}
+{
+    const auto file_descriptor = open(path.c_str(), O_RDONLY);
+    if (file_descriptor < 0)
+    {
+        throw std::runtime_error("Input file " + path + " not found");
+    }
+
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) != 0)
+    {
+        close(file_descriptor);
+        throw std::runtime_error("Failed to stat " + path);
+    }
+    size_ = static_cast<std::size_t>(file_status.st_size);
+
+    // mmap of an empty file fails, keep data_ as nullptr instead
+    if (size_ > 0U)
+    {
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (data == MAP_FAILED)
+        {
+            close(file_descriptor);
+            throw std::runtime_error("Failed to mmap " + path);
+        }
+        data_ = static_cast<std::uint8_t*>(data);
+        // whole file is read front to back by decoders
+        madvise(data, size_, MADV_SEQUENTIAL);
+    }
+    // mapping stays valid after closing the descriptor
+    close(file_descriptor);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : data_{other.data_}, size_{other.size_}
+{
+    other.data_ = nullptr;
+    other.size_ = 0U;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0U;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() { Reset(); }
+
+const std::uint8_t* MappedFile::GetData() const { return data_; }
+
+std::size_t MappedFile::GetSize() const { return size_; }
+
+void MappedFile::Reset()
+{
+    if (data_)
+    {
+        munmap(data_, size_);
+        data_ = nullptr;
+        size_ = 0U;
+    }
+}
+
+}  // namespace perception
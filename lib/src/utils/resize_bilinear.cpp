@@ -0,0 +1,378 @@
+///
+/// @file resize_bilinear.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "perception/utils/resize_bilinear.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief BT.601 luma weights (R, G, B)
+constexpr float kLumaWeightR = 0.299F;
+constexpr float kLumaWeightG = 0.587F;
+constexpr float kLumaWeightB = 0.114F;
+
+/// @brief BT.601 luma weights (R, G, B) in Q8 fixed-point
+constexpr std::int32_t kFixedLumaWeightR = 77;
+constexpr std::int32_t kFixedLumaWeightG = 150;
+constexpr std::int32_t kFixedLumaWeightB = 29;
+
+/// @brief Interpolation weights are Q11 fixed-point, blended pixels are Q22 after both passes
+constexpr std::int32_t kFractionBits = 11;
+constexpr std::int32_t kOne = 1 << kFractionBits;
+constexpr std::int32_t kRoundingBits = 2 * kFractionBits;
+
+/// @brief Q22 blended pixel -> pixel value [0, 255]
+inline std::int32_t RoundFixed(const std::int32_t value)
+{
+    return (value + (1 << (kRoundingBits - 1))) >> kRoundingBits;
+}
+
+/// @brief output[i] = (top[i] + (bottom[i] - top[i]) * dy) * scale + offset
+void InterpolateRowsScalar(const std::uint8_t* top, const std::uint8_t* bottom, const std::int32_t size,
+                           const float dy, const float scale, const float offset, float* output)
+{
+    for (std::int32_t i = 0; i < size; ++i)
+    {
+        const float t = top[i];
+        const float b = bottom[i];
+        output[i] = (t + (b - t) * dy) * scale + offset;
+    }
+}
+
+#ifdef PERCEPTION_X86_SIMD
+__attribute__((target("sse4.1"))) void InterpolateRowsSse41(const std::uint8_t* top, const std::uint8_t* bottom,
+                                                             const std::int32_t size, const float dy,
+                                                             const float scale, const float offset, float* output)
+{
+    const __m128 vdy = _mm_set1_ps(dy);
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 voffset = _mm_set1_ps(offset);
+    std::int32_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        std::int32_t top_word;
+        std::int32_t bottom_word;
+        std::memcpy(&top_word, top + i, sizeof(top_word));
+        std::memcpy(&bottom_word, bottom + i, sizeof(bottom_word));
+        const __m128 t = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(top_word)));
+        const __m128 b = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(bottom_word)));
+        const __m128 v = _mm_add_ps(t, _mm_mul_ps(_mm_sub_ps(b, t), vdy));
+        _mm_storeu_ps(output + i, _mm_add_ps(_mm_mul_ps(v, vscale), voffset));
+    }
+    InterpolateRowsScalar(top + i, bottom + i, size - i, dy, scale, offset, output + i);
+}
+
+__attribute__((target("avx2"))) void InterpolateRowsAvx2(const std::uint8_t* top, const std::uint8_t* bottom,
+                                                          const std::int32_t size, const float dy, const float scale,
+                                                          const float offset, float* output)
+{
+    const __m256 vdy = _mm256_set1_ps(dy);
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 voffset = _mm256_set1_ps(offset);
+    std::int32_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m256 t =
+            _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(top + i))));
+        const __m256 b =
+            _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(bottom + i))));
+        const __m256 v = _mm256_add_ps(t, _mm256_mul_ps(_mm256_sub_ps(b, t), vdy));
+        _mm256_storeu_ps(output + i, _mm256_add_ps(_mm256_mul_ps(v, vscale), voffset));
+    }
+    InterpolateRowsScalar(top + i, bottom + i, size - i, dy, scale, offset, output + i);
+}
+#endif
+
+/// @brief output[i] = top[i] * (kOne - dy) + bottom[i] * dy
+void InterpolateRowsFixedScalar(const std::uint8_t* top, const std::uint8_t* bottom, const std::int32_t size,
+                                const std::int32_t dy, std::int32_t* output)
+{
+    const std::int32_t inverse_dy = kOne - dy;
+    for (std::int32_t i = 0; i < size; ++i)
+    {
+        output[i] = top[i] * inverse_dy + bottom[i] * dy;
+    }
+}
+
+#ifdef PERCEPTION_X86_SIMD
+/// @brief (kOne - dy, dy) pair, packed as 16-bit weights for multiply-add
+inline std::int32_t PackWeights(const std::int32_t dy)
+{
+    return static_cast<std::int32_t>((static_cast<std::uint32_t>(dy) << 16) | static_cast<std::uint32_t>(kOne - dy));
+}
+
+__attribute__((target("sse2"))) void InterpolateRowsFixedSse2(const std::uint8_t* top, const std::uint8_t* bottom,
+                                                               const std::int32_t size, const std::int32_t dy,
+                                                               std::int32_t* output)
+{
+    const __m128i weights = _mm_set1_epi32(PackWeights(dy));
+    const __m128i zero = _mm_setzero_si128();
+    std::int32_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m128i t = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(top + i)), zero);
+        const __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(bottom + i)), zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_madd_epi16(_mm_unpacklo_epi16(t, b), weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 4),
+                         _mm_madd_epi16(_mm_unpackhi_epi16(t, b), weights));
+    }
+    InterpolateRowsFixedScalar(top + i, bottom + i, size - i, dy, output + i);
+}
+
+__attribute__((target("avx2"))) void InterpolateRowsFixedAvx2(const std::uint8_t* top, const std::uint8_t* bottom,
+                                                               const std::int32_t size, const std::int32_t dy,
+                                                               std::int32_t* output)
+{
+    const __m256i weights = _mm256_set1_epi32(PackWeights(dy));
+    std::int32_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m256i t = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(top + i)));
+        const __m256i b = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + i)));
+        // unpack works per 128-bit lane, i.e. low holds elements [0, 4) and [8, 12), high [4, 8) and [12, 16)
+        const __m256i low = _mm256_madd_epi16(_mm256_unpacklo_epi16(t, b), weights);
+        const __m256i high = _mm256_madd_epi16(_mm256_unpackhi_epi16(t, b), weights);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_permute2x128_si256(low, high, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i + 8), _mm256_permute2x128_si256(low, high, 0x31));
+    }
+    InterpolateRowsFixedScalar(top + i, bottom + i, size - i, dy, output + i);
+}
+#endif
+
+/// @brief Quantizes pixel value, given normalization and quantization parameters
+template <typename T>
+void FillQuantizationTable(const float input_mean, const float input_std, const float scale,
+                           const std::int32_t zero_point, T* table)
+{
+    const std::int32_t minimum = std::numeric_limits<T>::min();
+    const std::int32_t maximum = std::numeric_limits<T>::max();
+    for (std::int32_t pixel = 0; pixel < 256; ++pixel)
+    {
+        std::int32_t value = pixel + minimum;
+        if (scale != 0.0F)
+        {
+            const float real_value = (pixel - input_mean) / input_std;
+            value = static_cast<std::int32_t>(std::round(real_value / scale)) + zero_point;
+        }
+        table[pixel] = static_cast<T>(std::min(std::max(value, minimum), maximum));
+    }
+}
+
+}  // namespace
+
+BilinearResizer::BilinearResizer(const std::int32_t input_height, const std::int32_t input_width,
+                                 const std::int32_t input_channels, const std::int32_t output_height,
+                                 const std::int32_t output_width, const std::int32_t output_channels,
+                                 const InstructionSet instruction_set)
+    : input_width_{input_width},
+      input_channels_{input_channels},
+      output_height_{output_height},
+      output_width_{output_width},
+      output_channels_{output_channels},
+      y0_(output_height),
+      y1_(output_height),
+      dy_(output_height),
+      fixed_dy_(output_height),
+      x0_(output_width),
+      x1_(output_width),
+      dx_(output_width),
+      fixed_dx_(output_width),
+      channel_map_(output_channels),
+      luma_{(output_channels == 1) && (input_channels >= 3)},
+      row_(input_width * input_channels),
+      fixed_row_(input_width * input_channels),
+      identity_table_(256),
+      interpolate_rows_{InterpolateRowsScalar},
+      interpolate_rows_fixed_{InterpolateRowsFixedScalar}
+{
+    if ((input_height <= 0) || (input_width <= 0) || (input_channels <= 0) || (output_height <= 0) ||
+        (output_width <= 0) || (output_channels <= 0))
+    {
+        throw std::runtime_error("Invalid resize dimensions.");
+    }
+    if ((input_channels != output_channels) && (input_channels != 1) && (input_channels < output_channels))
+    {
+        throw std::runtime_error("Unable to map " + std::to_string(input_channels) + " channels to " +
+                                 std::to_string(output_channels) + " channels.");
+    }
+
+    // same sampling as TFLite RESIZE_BILINEAR with align_corners = false
+    const float height_scale = static_cast<float>(input_height) / output_height;
+    for (std::int32_t y = 0; y < output_height; ++y)
+    {
+        const float input_y = y * height_scale;
+        y0_[y] = static_cast<std::int32_t>(std::floor(input_y));
+        y1_[y] = std::min(y0_[y] + 1, input_height - 1);
+        dy_[y] = input_y - y0_[y];
+        fixed_dy_[y] = static_cast<std::int32_t>(std::round(dy_[y] * kOne));
+    }
+    const float width_scale = static_cast<float>(input_width) / output_width;
+    for (std::int32_t x = 0; x < output_width; ++x)
+    {
+        const float input_x = x * width_scale;
+        const auto x0 = static_cast<std::int32_t>(std::floor(input_x));
+        x0_[x] = x0 * input_channels;
+        x1_[x] = std::min(x0 + 1, input_width - 1) * input_channels;
+        dx_[x] = input_x - x0;
+        fixed_dx_[x] = static_cast<std::int32_t>(std::round(dx_[x] * kOne));
+    }
+    for (std::int32_t c = 0; c < output_channels; ++c)
+    {
+        channel_map_[c] = std::min(c, input_channels - 1);
+    }
+    std::iota(identity_table_.begin(), identity_table_.end(), 0U);
+
+#ifdef PERCEPTION_X86_SIMD
+    if (instruction_set >= InstructionSet::kAvx2)
+    {
+        interpolate_rows_ = InterpolateRowsAvx2;
+        interpolate_rows_fixed_ = InterpolateRowsFixedAvx2;
+    }
+    else if (instruction_set >= InstructionSet::kSse41)
+    {
+        interpolate_rows_ = InterpolateRowsSse41;
+        interpolate_rows_fixed_ = InterpolateRowsFixedSse2;
+    }
+    else if (instruction_set >= InstructionSet::kSse2)
+    {
+        interpolate_rows_fixed_ = InterpolateRowsFixedSse2;
+    }
+#endif
+}
+
+void BilinearResizer::Resize(const std::uint8_t* input, const float scale, const float offset, float* output)
+{
+    const std::int32_t input_row_size = input_width_ * input_channels_;
+    const std::int32_t output_row_size = output_width_ * output_channels_;
+
+    std::int32_t blended_y0 = -1;
+    float blended_dy = 0.0F;
+    for (std::int32_t y = 0; y < output_height_; ++y)
+    {
+        // upscaling revisits same source rows with same weight, skip blending them again
+        if ((y0_[y] != blended_y0) || (dy_[y] != blended_dy))
+        {
+            interpolate_rows_(input + y0_[y] * input_row_size, input + y1_[y] * input_row_size, input_row_size,
+                              dy_[y], scale, offset, row_.data());
+            blended_y0 = y0_[y];
+            blended_dy = dy_[y];
+        }
+        InterpolateColumns(output + y * output_row_size);
+    }
+}
+
+void BilinearResizer::Resize(const std::uint8_t* input, std::uint8_t* output)
+{
+    ResizeFixed<std::uint8_t>(input, identity_table_.data(), output);
+}
+
+void BilinearResizer::Resize(const std::uint8_t* input, const std::uint8_t* table, std::uint8_t* output)
+{
+    ResizeFixed<std::uint8_t>(input, table, output);
+}
+
+void BilinearResizer::Resize(const std::uint8_t* input, const std::int8_t* table, std::int8_t* output)
+{
+    ResizeFixed<std::int8_t>(input, table, output);
+}
+
+void BilinearResizer::InterpolateColumns(float* output) const
+{
+    const float* row = row_.data();
+    for (std::int32_t x = 0; x < output_width_; ++x)
+    {
+        const float* left = row + x0_[x];
+        const float* right = row + x1_[x];
+        const float dx = dx_[x];
+        if (luma_)
+        {
+            const float r = left[0] + (right[0] - left[0]) * dx;
+            const float g = left[1] + (right[1] - left[1]) * dx;
+            const float b = left[2] + (right[2] - left[2]) * dx;
+            output[x] = kLumaWeightR * r + kLumaWeightG * g + kLumaWeightB * b;
+            continue;
+        }
+        float* pixel = output + x * output_channels_;
+        for (std::int32_t c = 0; c < output_channels_; ++c)
+        {
+            const std::int32_t channel = channel_map_[c];
+            pixel[c] = left[channel] + (right[channel] - left[channel]) * dx;
+        }
+    }
+}
+
+template <typename T>
+void BilinearResizer::ResizeFixed(const std::uint8_t* input, const T* table, T* output)
+{
+    const std::int32_t input_row_size = input_width_ * input_channels_;
+    const std::int32_t output_row_size = output_width_ * output_channels_;
+
+    std::int32_t blended_y0 = -1;
+    std::int32_t blended_dy = 0;
+    for (std::int32_t y = 0; y < output_height_; ++y)
+    {
+        if ((y0_[y] != blended_y0) || (fixed_dy_[y] != blended_dy))
+        {
+            interpolate_rows_fixed_(input + y0_[y] * input_row_size, input + y1_[y] * input_row_size, input_row_size,
+                                    fixed_dy_[y], fixed_row_.data());
+            blended_y0 = y0_[y];
+            blended_dy = fixed_dy_[y];
+        }
+        InterpolateColumnsFixed<T>(table, output + y * output_row_size);
+    }
+}
+
+template <typename T>
+void BilinearResizer::InterpolateColumnsFixed(const T* table, T* output) const
+{
+    const std::int32_t* row = fixed_row_.data();
+    for (std::int32_t x = 0; x < output_width_; ++x)
+    {
+        const std::int32_t* left = row + x0_[x];
+        const std::int32_t* right = row + x1_[x];
+        const std::int32_t dx = fixed_dx_[x];
+        const std::int32_t inverse_dx = kOne - dx;
+        if (luma_)
+        {
+            const std::int32_t r = RoundFixed(left[0] * inverse_dx + right[0] * dx);
+            const std::int32_t g = RoundFixed(left[1] * inverse_dx + right[1] * dx);
+            const std::int32_t b = RoundFixed(left[2] * inverse_dx + right[2] * dx);
+            output[x] = table[(kFixedLumaWeightR * r + kFixedLumaWeightG * g + kFixedLumaWeightB * b + 128) >> 8];
+            continue;
+        }
+        T* pixel = output + x * output_channels_;
+        for (std::int32_t c = 0; c < output_channels_; ++c)
+        {
+            const std::int32_t channel = channel_map_[c];
+            pixel[c] = table[RoundFixed(left[channel] * inverse_dx + right[channel] * dx)];
+        }
+    }
+}
+
+void CreateQuantizationTable(const float input_mean, const float input_std, const float scale,
+                             const std::int32_t zero_point, std::uint8_t* table)
+{
+    FillQuantizationTable<std::uint8_t>(input_mean, input_std, scale, zero_point, table);
+}
+
+void CreateQuantizationTable(const float input_mean, const float input_std, const float scale,
+                             const std::int32_t zero_point, std::int8_t* table)
+{
+    FillQuantizationTable<std::int8_t>(input_mean, input_std, scale, zero_point, table);
+}
+
+}  // namespace perception
@@ -0,0 +1,118 @@
+///
+/// @file thread_pool.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "perception/utils/thread_pool.h"
+
+namespace perception
+{
+ThreadPool::ThreadPool(const std::size_t number_of_threads)
+    : workers_{},
+      call_mutex_{},
+      mutex_{},
+      work_available_{},
+      work_done_{},
+      task_{nullptr},
+      count_{0U},
+      generation_{0U},
+      active_workers_{0U},
+      next_index_{0U},
+      error_{},
+      stopping_{false}
+{
+    for (std::size_t index = 1U; index < number_of_threads; ++index)
+    {
+        workers_.emplace_back([this]() { Work(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::GetSize() const { return workers_.size() + 1U; }
+
+void ThreadPool::ParallelFor(const std::size_t count, const Task& task)
+{
+    std::lock_guard<std::mutex> call_lock{call_mutex_};
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        task_ = &task;
+        count_ = count;
+        error_ = nullptr;
+        next_index_.store(0U, std::memory_order_relaxed);
+        ++generation_;
+    }
+    work_available_.notify_all();
+
+    RunTasks(task, count);
+
+    // workers which did not pick up the job by now never will (task_ is reset under the lock)
+    std::unique_lock<std::mutex> lock{mutex_};
+    work_done_.wait(lock, [this]() { return active_workers_ == 0U; });
+    task_ = nullptr;
+    if (error_)
+    {
+        std::rethrow_exception(error_);
+    }
+}
+
+void ThreadPool::Work()
+{
+    std::uint64_t generation = 0U;
+    std::unique_lock<std::mutex> lock{mutex_};
+    while (true)
+    {
+        work_available_.wait(lock, [&]() { return stopping_ || (generation != generation_); });
+        if (stopping_)
+        {
+            return;
+        }
+        generation = generation_;
+        if (!task_)
+        {
+            continue;
+        }
+
+        const auto& task = *task_;
+        const auto count = count_;
+        ++active_workers_;
+        lock.unlock();
+        RunTasks(task, count);
+        lock.lock();
+        if (--active_workers_ == 0U)
+        {
+            work_done_.notify_all();
+        }
+    }
+}
+
+void ThreadPool::RunTasks(const Task& task, const std::size_t count)
+{
+    for (auto index = next_index_.fetch_add(1U); index < count; index = next_index_.fetch_add(1U))
+    {
+        try
+        {
+            task(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (!error_)
+            {
+                error_ = std::current_exception();
+            }
+        }
+    }
+}
+
+}  // namespace perception
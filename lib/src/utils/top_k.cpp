@@ -0,0 +1,268 @@
+///
+/// @file top_k.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+#include "perception/utils/top_k.h"
+
+namespace perception
+{
+namespace
+{
+/// @brief Sorted array of (at most) K candidates, in descending order of (score, index)
+template <typename T>
+class Candidates
+{
+  public:
+    /// @brief Constructor
+    /// @param [in] k - Number of candidates (K)
+    /// @param [in] threshold - Lowest score of candidates
+    /// @param [in] size - Number of scores, which limits number of candidates as well
+    Candidates(const std::size_t k, const T threshold, const std::int32_t size)
+        : k_{k}, threshold_{threshold}, entries_{}
+    {
+        entries_.reserve(std::min(k, static_cast<std::size_t>(std::max(size, 0))) + 1U);
+    }
+
+    /// @brief Lowest score which still becomes a candidate
+    T GetBound() const { return (entries_.size() < k_) ? threshold_ : std::max(threshold_, entries_.back().first); }
+
+    /// @brief Inserts score, indices must be pushed in ascending order (i.e. equal scores are replaced by later ones)
+    void Push(const T score, const std::int32_t index)
+    {
+        if (!(score >= GetBound()))
+        {
+            return;
+        }
+        const auto position = std::find_if(entries_.begin(), entries_.end(),
+                                           [score](const std::pair<T, std::int32_t>& entry) {
+                                               return entry.first <= score;
+                                           });
+        entries_.emplace(position, score, index);
+        if (entries_.size() > k_)
+        {
+            entries_.pop_back();
+        }
+    }
+
+    const std::vector<std::pair<T, std::int32_t>>& GetEntries() const { return entries_; }
+
+  private:
+    const std::size_t k_;
+    const T threshold_;
+    std::vector<std::pair<T, std::int32_t>> entries_;
+};
+
+template <typename T>
+using ScanFunction = void (*)(const T* scores, const std::int32_t size, Candidates<T>* candidates);
+
+template <typename T>
+void ScanScalar(const T* scores, const std::int32_t begin, const std::int32_t size, Candidates<T>* candidates)
+{
+    for (std::int32_t i = begin; i < size; ++i)
+    {
+        candidates->Push(scores[i], i);
+    }
+}
+
+template <typename T>
+void ScanScalar(const T* scores, const std::int32_t size, Candidates<T>* candidates)
+{
+    ScanScalar(scores, 0, size, candidates);
+}
+
+/// @brief Pushes scores of block starting at begin, which passed the bound (bit i set for score begin + i)
+template <typename T>
+inline void PushMasked(const T* scores, const std::int32_t begin, std::uint32_t mask, Candidates<T>* candidates)
+{
+    while (mask)
+    {
+        const auto index = begin + __builtin_ctz(mask);
+        candidates->Push(scores[index], index);
+        mask &= mask - 1U;
+    }
+}
+
+#ifdef PERCEPTION_X86_SIMD
+__attribute__((target("sse2"))) void ScanSse2(const std::uint8_t* scores, const std::int32_t size,
+                                              Candidates<std::uint8_t>* candidates)
+{
+    std::int32_t i = 0;
+    for (; (i + 16) <= size; i += 16)
+    {
+        // score >= bound, i.e. max(score, bound) == score
+        const __m128i bound = _mm_set1_epi8(static_cast<char>(candidates->GetBound()));
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&scores[i]));
+        PushMasked(scores, i, static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(x, bound), x))),
+                   candidates);
+    }
+    ScanScalar(scores, i, size, candidates);
+}
+
+__attribute__((target("sse2"))) void ScanSse2(const std::int8_t* scores, const std::int32_t size,
+                                              Candidates<std::int8_t>* candidates)
+{
+    std::int32_t i = 0;
+    for (; (i + 16) <= size; i += 16)
+    {
+        // score >= bound, i.e. !(bound > score)
+        const __m128i bound = _mm_set1_epi8(candidates->GetBound());
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&scores[i]));
+        PushMasked(scores, i, ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(bound, x))) & 0xFFFFU,
+                   candidates);
+    }
+    ScanScalar(scores, i, size, candidates);
+}
+
+__attribute__((target("sse2"))) void ScanSse2(const float* scores, const std::int32_t size,
+                                              Candidates<float>* candidates)
+{
+    std::int32_t i = 0;
+    for (; (i + 16) <= size; i += 16)
+    {
+        const __m128 bound = _mm_set1_ps(candidates->GetBound());
+        std::uint32_t mask = 0U;
+        for (std::int32_t j = 0; j < 4; ++j)
+        {
+            const __m128 x = _mm_loadu_ps(&scores[i + 4 * j]);
+            mask |= static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(x, bound))) << (4 * j);
+        }
+        PushMasked(scores, i, mask, candidates);
+    }
+    ScanScalar(scores, i, size, candidates);
+}
+
+__attribute__((target("avx2"))) void ScanAvx2(const std::uint8_t* scores, const std::int32_t size,
+                                              Candidates<std::uint8_t>* candidates)
+{
+    std::int32_t i = 0;
+    for (; (i + 32) <= size; i += 32)
+    {
+        const __m256i bound = _mm256_set1_epi8(static_cast<char>(candidates->GetBound()));
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&scores[i]));
+        PushMasked(scores, i,
+                   static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(x, bound), x))),
+                   candidates);
+    }
+    ScanScalar(scores, i, size, candidates);
+}
+
+__attribute__((target("avx2"))) void ScanAvx2(const std::int8_t* scores, const std::int32_t size,
+                                              Candidates<std::int8_t>* candidates)
+{
+    std::int32_t i = 0;
+    for (; (i + 32) <= size; i += 32)
+    {
+        const __m256i bound = _mm256_set1_epi8(candidates->GetBound());
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&scores[i]));
+        PushMasked(scores, i, ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(bound, x))),
+                   candidates);
+    }
+    ScanScalar(scores, i, size, candidates);
+}
+
+__attribute__((target("avx2"))) void ScanAvx2(const float* scores, const std::int32_t size,
+                                              Candidates<float>* candidates)
+{
+    std::int32_t i = 0;
+    for (; (i + 32) <= size; i += 32)
+    {
+        const __m256 bound = _mm256_set1_ps(candidates->GetBound());
+        std::uint32_t mask = 0U;
+        for (std::int32_t j = 0; j < 4; ++j)
+        {
+            const __m256 x = _mm256_loadu_ps(&scores[i + 8 * j]);
+            mask |= static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(x, bound, _CMP_GE_OQ))) << (8 * j);
+        }
+        PushMasked(scores, i, mask, candidates);
+    }
+    ScanScalar(scores, i, size, candidates);
+}
+#endif
+
+template <typename T>
+ScanFunction<T> GetScanFunction(const InstructionSet instruction_set)
+{
+#ifdef PERCEPTION_X86_SIMD
+    if (instruction_set >= InstructionSet::kAvx2)
+    {
+        return static_cast<ScanFunction<T>>(ScanAvx2);
+    }
+    if (instruction_set >= InstructionSet::kSse2)
+    {
+        return static_cast<ScanFunction<T>>(ScanSse2);
+    }
+#endif
+    return static_cast<ScanFunction<T>>(ScanScalar);
+}
+
+/// @brief Top K of quantized scores, dequantize must be non-decreasing (i.e. positive scale)
+template <typename T, typename Dequantize>
+TopKResults GetQuantizedTopK(const T* scores, const std::int32_t size, const std::size_t k, const float threshold,
+                             const Dequantize& dequantize, const InstructionSet instruction_set)
+{
+    // threshold within quantized domain, i.e. smallest score which passes it
+    std::int32_t minimum_score = std::numeric_limits<T>::min();
+    while ((minimum_score <= std::numeric_limits<T>::max()) && !(dequantize(minimum_score) >= threshold))
+    {
+        ++minimum_score;
+    }
+
+    TopKResults results;
+    if ((k == 0U) || (minimum_score > std::numeric_limits<T>::max()))
+    {
+        return results;
+    }
+    Candidates<T> candidates{k, static_cast<T>(minimum_score), size};
+    GetScanFunction<T>(instruction_set)(scores, size, &candidates);
+    for (const auto& entry : candidates.GetEntries())
+    {
+        results.emplace_back(dequantize(entry.first), entry.second);
+    }
+    return results;
+}
+}  // namespace
+
+TopKResults GetTopK(const float* scores, const std::int32_t size, const std::size_t k, const float threshold,
+                    const InstructionSet instruction_set)
+{
+    TopKResults results;
+    if (k == 0U)
+    {
+        return results;
+    }
+    Candidates<float> candidates{k, threshold, size};
+    GetScanFunction<float>(instruction_set)(scores, size, &candidates);
+    results.assign(candidates.GetEntries().begin(), candidates.GetEntries().end());
+    return results;
+}
+
+TopKResults GetTopK(const std::uint8_t* scores, const std::int32_t size, const std::size_t k, const float threshold,
+                    const float scale, const std::int32_t zero_point, const InstructionSet instruction_set)
+{
+    if (scale == 0.0F)
+    {
+        return GetQuantizedTopK(scores, size, k, threshold,
+                                [](const std::int32_t score) { return static_cast<float>(score / 255.0); },
+                                instruction_set);
+    }
+    return GetQuantizedTopK(scores, size, k, threshold,
+                            [scale, zero_point](const std::int32_t score) { return (score - zero_point) * scale; },
+                            instruction_set);
+}
+
+TopKResults GetTopK(const std::int8_t* scores, const std::int32_t size, const std::size_t k, const float threshold,
+                    const float scale, const std::int32_t zero_point, const InstructionSet instruction_set)
+{
+    return GetQuantizedTopK(scores, size, k, threshold,
+                            [scale, zero_point](const std::int32_t score) { return (score - zero_point) * scale; },
+                            instruction_set);
+}
+
+}  // namespace perception
@@ -31,6 +31,17 @@ TEST(ArgumentParserTest, DefaultConstructor)
     EXPECT_THAT(actual.labels_name, ::testing::Eq("data/labels.txt"));
     EXPECT_EQ(actual.model_name, "external/mobilenet_v2_1.0_224_quant/mobilenet_v2_1.0_224_quant.tflite");
     EXPECT_THAT(actual.result_directory, ::testing::Eq("results"));
+    EXPECT_FALSE(actual.benchmark);
+    EXPECT_EQ(actual.warmup_runs, 1);
+    EXPECT_FALSE(actual.pipeline);
+    EXPECT_EQ(actual.delegate, "none");
+    EXPECT_EQ(actual.decode_threads, 1);
+    EXPECT_EQ(actual.roi_width, 0);
+    EXPECT_EQ(actual.roi_height, 0);
+    EXPECT_EQ(actual.input_cache_mb, 64);
+    EXPECT_TRUE(actual.batch_input.empty());
+    EXPECT_EQ(actual.batch_workers, 4);
+    EXPECT_EQ(actual.batch_output, "batch_results.jsonl");
 }
 TEST(ArgumentParserTest, WhenHelpArgument)
 {
@@ -67,7 +78,27 @@ TEST(ArgumentParserTest, ParameterizedConstructor)
                     "-s",
                     "10.0",
                     "-b",
-                    "1"};
+                    "1",
+                    "-k",
+                    "1",
+                    "-w",
+                    "3",
+                    "-x",
+                    "1",
+                    "-g",
+                    "nnapi",
+                    "-j",
+                    "4",
+                    "-o",
+                    "16,32,224,112",
+                    "-q",
+                    "16",
+                    "-a",
+                    "data",
+                    "-n",
+                    "8",
+                    "-u",
+                    "results.csv"};
     int argc = sizeof(argv) / sizeof(char*);
     auto unit = ArgumentParser(argc, argv);
     auto actual = unit.GetParsedArgs();
@@ -85,6 +116,19 @@ TEST(ArgumentParserTest, ParameterizedConstructor)
     EXPECT_THAT(actual.model_name, ::testing::Eq("test_model.tflite"));
     EXPECT_THAT(actual.labels_name, ::testing::Eq("labels.txt"));
     EXPECT_THAT(actual.result_directory, ::testing::Eq("data/intermediate_tensors"));
+    EXPECT_TRUE(actual.benchmark);
+    EXPECT_EQ(actual.warmup_runs, 3);
+    EXPECT_TRUE(actual.pipeline);
+    EXPECT_EQ(actual.delegate, "nnapi");
+    EXPECT_EQ(actual.decode_threads, 4);
+    EXPECT_EQ(actual.roi_x, 16);
+    EXPECT_EQ(actual.roi_y, 32);
+    EXPECT_EQ(actual.roi_width, 224);
+    EXPECT_EQ(actual.roi_height, 112);
+    EXPECT_EQ(actual.input_cache_mb, 16);
+    EXPECT_EQ(actual.batch_input, "data");
+    EXPECT_EQ(actual.batch_workers, 8);
+    EXPECT_EQ(actual.batch_output, "results.csv");
 }
 }  // namespace
 }  // namespace perception
\ No newline at end of file
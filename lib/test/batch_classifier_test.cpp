@@ -0,0 +1,115 @@
+///
+/// @file batch_classifier_test.cpp
+/// @brief Contains unit tests for Batch Classifier and Batch Result Writer APIs
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "perception/argument_parser/cli_options.h"
+#include "perception/inference_engine/batch_classifier.h"
+#include "perception/inference_engine/batch_result_writer.h"
+#include "perception/inference_engine/interpreter_pool.h"
+#include "perception/utils/label_table.h"
+
+namespace perception
+{
+namespace
+{
+TEST(BatchClassifierTest, GivenImagesWithInvalidImage_WhenRun_ExpectResultPerImageAndFailureReported)
+{
+    const CLIOptions cli_options{};
+    InterpreterPool pool{cli_options.model_name, 2U, 1};
+    BatchClassifier unit{&pool, cli_options.input_mean, cli_options.input_std, cli_options.number_of_results, 3U};
+    const std::vector<std::string> image_paths{"data/grace_hopper.bmp", "invalid.bmp", cli_options.input_name,
+                                               "data/grace_hopper.bmp"};
+
+    std::vector<BatchResult> results(image_paths.size());
+    const auto statistics =
+        unit.Run(image_paths, [&results](const BatchResult& result) { results[result.image_index] = result; });
+
+    EXPECT_EQ(statistics.images, 3U);
+    EXPECT_EQ(statistics.failures, 1U);
+    EXPECT_EQ(statistics.latency.GetCount(), 3U);
+    EXPECT_GT(statistics.images_per_second, 0.0);
+    EXPECT_EQ(results[0].results.size(), cli_options.number_of_results);
+    EXPECT_EQ(results[0].results, results[3].results);
+    EXPECT_TRUE(results[1].results.empty());
+    EXPECT_FALSE(results[1].error.empty());
+    EXPECT_EQ(pool.GetAvailableCount(), pool.GetSize());
+}
+
+TEST(BatchClassifierTest, GivenThrowingCallback_WhenRun_ExpectException)
+{
+    const CLIOptions cli_options{};
+    InterpreterPool pool{cli_options.model_name, 1U, 1};
+    BatchClassifier unit{&pool, cli_options.input_mean, cli_options.input_std, cli_options.number_of_results, 2U};
+
+    EXPECT_THROW(unit.Run({"data/grace_hopper.bmp", cli_options.input_name},
+                          [](const BatchResult&) { throw std::runtime_error("disk full"); }),
+                 std::runtime_error);
+}
+
+TEST(BatchClassifierTest, GivenDirectoryOrManifest_WhenListImages_ExpectImagePaths)
+{
+    EXPECT_THAT(BatchClassifier::ListImages("data"),
+                ::testing::ElementsAre("data/grace_hopper.bmp", "data/grace_hopper.jpg"));
+
+    std::ofstream{"manifest.txt"} << "# nightly\ndata/grace_hopper.jpg\n\n  data/grace_hopper.bmp \n";
+    EXPECT_THAT(BatchClassifier::ListImages("manifest.txt"),
+                ::testing::ElementsAre("data/grace_hopper.jpg", "data/grace_hopper.bmp"));
+
+    EXPECT_THROW(BatchClassifier::ListImages("invalid.txt"), std::runtime_error);
+}
+
+/// @brief Labels of BatchResultWriter tests, i.e. with separators and quotes
+LabelTable CreateLabels()
+{
+    std::ofstream{"batch_labels.txt"} << "background\nfish, large\ngold\"fish\n";
+    return LabelTable::Load("batch_labels.txt");
+}
+
+TEST(BatchResultWriterTest, GivenCsvPath_WhenWrite_ExpectRowPerResult)
+{
+    const auto labels = CreateLabels();
+    {
+        BatchResultWriter unit{"batch_results.csv", labels};
+        EXPECT_EQ(unit.GetFormat(), BatchResultWriter::Format::kCsv);
+        unit.Write(BatchResult{0U, "a,b.jpg", {{0.5F, 1}, {0.25F, 2}}, 1.5, ""});
+        unit.Write(BatchResult{1U, "c.jpg", {}, 0.5, "not found"});
+    }
+
+    std::ifstream file{"batch_results.csv"};
+    const std::string content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    EXPECT_EQ(content,
+              "image,rank,index,label,confidence,latency_ms,error\n"
+              "\"a,b.jpg\",0,1,\"fish, large\",0.5,1.5,\n"
+              "\"a,b.jpg\",1,2,\"gold\"\"fish\",0.25,1.5,\n"
+              "c.jpg,,,,,0.5,not found\n");
+}
+
+TEST(BatchResultWriterTest, GivenJsonLinesPath_WhenWrite_ExpectObjectPerImage)
+{
+    const auto labels = CreateLabels();
+    {
+        BatchResultWriter unit{"batch_results.jsonl", labels};
+        EXPECT_EQ(unit.GetFormat(), BatchResultWriter::Format::kJsonLines);
+        unit.Write(BatchResult{0U, "a.jpg", {{0.5F, 2}}, 1.5, ""});
+        unit.Write(BatchResult{1U, "c.jpg", {}, 0.5, "not found"});
+    }
+
+    std::ifstream file{"batch_results.jsonl"};
+    const std::string content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    EXPECT_EQ(content,
+              "{\"image\": \"a.jpg\", \"latency_ms\": 1.5, \"results\": [{\"index\": 2, \"label\": \"gold\\\"fish\", "
+              "\"confidence\": 0.5}]}\n"
+              "{\"image\": \"c.jpg\", \"latency_ms\": 0.5, \"results\": [], \"error\": \"not found\"}\n");
+}
+
+}  // namespace
+}  // namespace perception
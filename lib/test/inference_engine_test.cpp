@@ -5,15 +5,27 @@
 ///
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
 
 #define private public
 #define protected public
+#include "perception/image_helper/bitmap_helper.h"
+#include "perception/inference_engine/delegate_registry.h"
 #include "perception/inference_engine/tflite_inference_engine.h"
 
 namespace perception
 {
 namespace
 {
+/// @brief Delegate, which fails to prepare any graph
+TfLiteStatus RejectingDelegatePrepare(TfLiteContext* /* context */, TfLiteDelegate* /* delegate */)
+{
+    return kTfLiteError;
+}
+
 TEST(TFLiteInferenceEngineTest, WhenInitialized)
 {
     TFLiteInferenceEngine unit;
@@ -60,8 +72,125 @@ TEST(TFLiteInferenceEngineTest, WhenExecuteWithCLIOptions)
     TFLiteInferenceEngine unit{cli_options};
     EXPECT_NO_THROW(unit.Init());
 
+    EXPECT_NO_THROW(unit.Execute());
+    EXPECT_NO_THROW(unit.Execute());
+    EXPECT_NO_THROW(unit.Shutdown());
+
+    EXPECT_EQ(unit.GetResults().size(), cli_options.number_of_results);
+    std::ifstream results_file{cli_options.result_directory + "/results.txt"};
+    ASSERT_TRUE(results_file.is_open());
+    const std::string content{std::istreambuf_iterator<char>{results_file}, std::istreambuf_iterator<char>{}};
+    // results of both frames appended, not overwritten
+    EXPECT_THAT(content, ::testing::HasSubstr("### frame 0: top_k_results.txt"));
+    EXPECT_THAT(content, ::testing::HasSubstr("### frame 1: top_k_results.txt"));
+    EXPECT_THAT(content, ::testing::HasSubstr("### frame 1: images_per_second.txt"));
+}
+
+TEST(TFLiteInferenceEngineTest, WhenExecuteBatch)
+{
+    DecodedImage image{};
+    BitmapImageHelper image_helper;
+    image.data = image_helper.ReadImage("data/grace_hopper.bmp", &image.width, &image.height, &image.channels);
+    TFLiteInferenceEngine unit;
+    EXPECT_NO_THROW(unit.Init());
+
+    const auto results = unit.ExecuteBatch({image, image, image});
+    unit.ExecuteBatch({image, image, image});
+
+    EXPECT_EQ(unit.batch_interpreters_.size(), 1U);
+    ASSERT_EQ(results.size(), 3U);
+    EXPECT_EQ(results[0].size(), CLIOptions().number_of_results);
+    EXPECT_EQ(results[0], results[1]);
+    EXPECT_EQ(results[0], results[2]);
+}
+
+TEST(TFLiteInferenceEngineTest, WhenBenchmark)
+{
+    CLIOptions cli_options;
+    cli_options.benchmark = true;
+    cli_options.warmup_runs = 1;
+    cli_options.loop_count = 3;
+    TFLiteInferenceEngine unit{cli_options};
+    EXPECT_NO_THROW(unit.Init());
+
+    EXPECT_NO_THROW(unit.Execute());
+
+    std::ifstream benchmark_file{cli_options.result_directory + "/benchmark.json"};
+    ASSERT_TRUE(benchmark_file.is_open());
+    const std::string content{std::istreambuf_iterator<char>{benchmark_file}, std::istreambuf_iterator<char>{}};
+    EXPECT_THAT(content, ::testing::HasSubstr("\"invoke\": {\"count\": 3"));
+    // warmup run preprocesses the image, measured runs hit the input cache
+    EXPECT_THAT(content, ::testing::HasSubstr("\"input_cache_hits\": 3"));
+}
+
+TEST(TFLiteInferenceEngineTest, WhenPipelineMode)
+{
+    CLIOptions cli_options;
+    cli_options.pipeline = true;
+    cli_options.loop_count = 3;
+    cli_options.decode_threads = 2;
+    cli_options.roi_width = 224;
+    cli_options.roi_height = 224;
+    TFLiteInferenceEngine unit{cli_options};
+    EXPECT_NO_THROW(unit.Init());
+
+    EXPECT_NO_THROW(unit.Execute());
+
+    // all the frames are streamed within single Execute()
+    EXPECT_EQ(unit.frame_index_, 3U);
+}
+
+TEST(TFLiteInferenceEngineTest, WhenBatchMode)
+{
+    CLIOptions cli_options;
+    cli_options.batch_input = "data";
+    cli_options.batch_workers = 2;
+    TFLiteInferenceEngine unit{cli_options};
+    EXPECT_NO_THROW(unit.Init());
+    // batch mode classifies on an interpreter pool sharing the model
+    EXPECT_EQ(unit.interpreter_, nullptr);
+
+    EXPECT_NO_THROW(unit.Execute());
+
+    std::ifstream results_file{cli_options.result_directory + "/" + cli_options.batch_output};
+    ASSERT_TRUE(results_file.is_open());
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(results_file, line);)
+    {
+        lines.push_back(line);
+    }
+    // data/grace_hopper.bmp and data/grace_hopper.jpg
+    EXPECT_EQ(lines.size(), 2U);
+    std::ifstream statistics_file{cli_options.result_directory + "/batch_statistics.json"};
+    ASSERT_TRUE(statistics_file.is_open());
+    const std::string content{std::istreambuf_iterator<char>{statistics_file}, std::istreambuf_iterator<char>{}};
+    EXPECT_THAT(content, ::testing::HasSubstr("\"images\": 2"));
+}
+
+TEST(TFLiteInferenceEngineTest, GivenUnknownDelegate_WhenInit_ExpectException)
+{
+    CLIOptions cli_options;
+    cli_options.delegate = "unknown";
+    TFLiteInferenceEngine unit{cli_options};
+
+    EXPECT_THROW(unit.Init(), std::runtime_error);
+}
+
+TEST(TFLiteInferenceEngineTest, GivenRejectingDelegate_WhenInit_ExpectFallbackToBuiltinKernels)
+{
+    static TfLiteDelegate rejecting_delegate{};
+    rejecting_delegate.Prepare = RejectingDelegatePrepare;
+    DelegateRegistry::GetInstance().Register("rejecting", []() {
+        return tflite::Interpreter::TfLiteDelegatePtr{&rejecting_delegate, [](TfLiteDelegate*) {}};
+    });
+    CLIOptions cli_options;
+    cli_options.delegate = "rejecting";
+    TFLiteInferenceEngine unit{cli_options};
+
+    EXPECT_NO_THROW(unit.Init());
     EXPECT_NO_THROW(unit.Execute());
 
+    EXPECT_EQ(unit.delegate_.get(), nullptr);
     EXPECT_EQ(unit.GetResults().size(), cli_options.number_of_results);
 }
 
@@ -75,7 +204,7 @@ TEST(TFLiteInferenceEngineTest, WhenInvalidLabelPath)
 {
     TFLiteInferenceEngine unit;
     unit.cli_options_.labels_name = "test.txt";
-    EXPECT_EXIT(unit.GetLabelList(), ::testing::KilledBySignal(SIGABRT), "");
+    EXPECT_EXIT(unit.LoadLabels(), ::testing::KilledBySignal(SIGABRT), "");
 }
 }  // namespace
 }  // namespace perception
\ No newline at end of file
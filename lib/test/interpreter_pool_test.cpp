@@ -0,0 +1,115 @@
+///
+/// @file interpreter_pool_test.cpp
+/// @brief Contains unit tests for Interpreter Pool APIs
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "perception/argument_parser/cli_options.h"
+#include "perception/inference_engine/interpreter_pool.h"
+
+namespace perception
+{
+namespace
+{
+class InterpreterPoolTestFixture : public ::testing::Test
+{
+  public:
+    InterpreterPoolTestFixture() : unit_{CLIOptions{}.model_name, 2U, 1} {}
+
+  protected:
+    InterpreterPool unit_;
+};
+
+TEST_F(InterpreterPoolTestFixture, WhenAcquire_ExpectDistinctInterpretersUntilExhausted)
+{
+    auto first = unit_.TryAcquire();
+    auto second = unit_.TryAcquire();
+    auto third = unit_.TryAcquire();
+
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_NE(first.get(), second.get());
+    EXPECT_FALSE(third);
+    EXPECT_EQ(unit_.GetAvailableCount(), 0U);
+}
+
+TEST_F(InterpreterPoolTestFixture, WhenLeaseReleased_ExpectInterpreterReturned)
+{
+    {
+        auto lease = unit_.Acquire();
+        EXPECT_EQ(unit_.GetAvailableCount(), 1U);
+    }
+    EXPECT_EQ(unit_.GetAvailableCount(), unit_.GetSize());
+}
+
+TEST_F(InterpreterPoolTestFixture, GivenMultipleThreads_WhenInvoke_ExpectNoSharedInterpreter)
+{
+    std::atomic<std::int32_t> concurrent{0};
+    std::atomic<std::int32_t> failures{0};
+    std::vector<std::thread> workers;
+    for (std::int32_t i = 0; i < 4; ++i)
+    {
+        workers.emplace_back([&]() {
+            for (std::int32_t iteration = 0; iteration < 2; ++iteration)
+            {
+                auto lease = unit_.Acquire();
+                if (++concurrent > static_cast<std::int32_t>(unit_.GetSize()))
+                {
+                    ++failures;
+                }
+                if (lease->Invoke() != kTfLiteOk)
+                {
+                    ++failures;
+                }
+                --concurrent;
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(unit_.GetAvailableCount(), unit_.GetSize());
+}
+
+TEST_F(InterpreterPoolTestFixture, GivenExhaustedPool_WhenAcquire_ExpectWaitUntilLeaseReleased)
+{
+    auto first = unit_.Acquire();
+    auto second = unit_.Acquire();
+    std::atomic<bool> acquired{false};
+    std::thread waiter{[&]() {
+        auto lease = unit_.Acquire();
+        acquired = static_cast<bool>(lease);
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(acquired);
+    second.Reset();
+    waiter.join();
+
+    EXPECT_TRUE(acquired);
+    EXPECT_EQ(unit_.GetAvailableCount(), 1U);
+}
+
+TEST(InterpreterPoolTest, GivenMappedModel_WhenCreatePool_ExpectModelShared)
+{
+    const auto model = tflite::FlatBufferModel::BuildFromFile(CLIOptions{}.model_name.c_str());
+    ASSERT_NE(model, nullptr);
+
+    InterpreterPool unit{*model, 2U, 1};
+
+    EXPECT_EQ(&unit.GetModel(), model.get());
+    EXPECT_EQ(unit.GetSize(), 2U);
+    EXPECT_EQ(unit.Acquire()->Invoke(), kTfLiteOk);
+}
+
+}  // namespace
+}  // namespace perception
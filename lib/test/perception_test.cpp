@@ -6,7 +6,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#define private public
 #include "perception/argument_parser/argument_parser.h"
 #include "perception/perception.h"
 
@@ -14,6 +18,25 @@ namespace perception
 {
 namespace
 {
+class MockArgumentParser : public IArgumentParser
+{
+  public:
+    MOCK_CONST_METHOD0(GetParsedArgs, CLIOptions());
+
+  protected:
+    MOCK_METHOD2(ParseArgs, CLIOptions(int, char**));
+};
+
+class MockInferenceEngine : public IInferenceEngine
+{
+  public:
+    MOCK_METHOD0(Init, void());
+    MOCK_METHOD0(Execute, void());
+    MOCK_METHOD0(Shutdown, void());
+    MOCK_CONST_METHOD0(GetIntermediateOutput, std::vector<std::pair<std::string, std::string>>());
+    MOCK_CONST_METHOD0(GetResults, std::vector<std::pair<float, std::int32_t>>());
+};
+
 class PerceptionTestFixture : public ::testing::Test
 {
   public:
@@ -49,6 +72,36 @@ TEST_F(PerceptionTestFixture, WhenExecute)
     EXPECT_NO_THROW(unit_->Shutdown());
 }
 
+TEST(PerceptionTest, GivenBatchInput_WhenExecute_ExpectSinglePass)
+{
+    CLIOptions cli_options;
+    cli_options.batch_input = "data";
+    cli_options.loop_count = 3;
+    auto argument_parser = std::make_unique<MockArgumentParser>();
+    EXPECT_CALL(*argument_parser, GetParsedArgs()).WillRepeatedly(::testing::Return(cli_options));
+    auto inference_engine = std::make_unique<MockInferenceEngine>();
+    EXPECT_CALL(*inference_engine, Execute()).Times(1);
+    Perception unit{std::move(argument_parser)};
+    unit.inference_engine_ = std::move(inference_engine);
+
+    unit.Execute();
+}
+
+TEST(PerceptionTest, GivenPipelineMode_WhenExecute_ExpectSinglePass)
+{
+    CLIOptions cli_options;
+    cli_options.pipeline = true;
+    cli_options.loop_count = 3;
+    auto argument_parser = std::make_unique<MockArgumentParser>();
+    EXPECT_CALL(*argument_parser, GetParsedArgs()).WillRepeatedly(::testing::Return(cli_options));
+    auto inference_engine = std::make_unique<MockInferenceEngine>();
+    EXPECT_CALL(*inference_engine, Execute()).Times(1);
+    Perception unit{std::move(argument_parser)};
+    unit.inference_engine_ = std::move(inference_engine);
+
+    unit.Execute();
+}
+
 TEST_F(PerceptionTestFixture, WhenInvalidInferenceEngine)
 {
     EXPECT_THROW(unit_->SelectInferenceEngine(Perception::InferenceEngineType::kInvalid), std::runtime_error);
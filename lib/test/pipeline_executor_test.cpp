@@ -0,0 +1,126 @@
+///
+/// @file pipeline_executor_test.cpp
+/// @brief Contains unit tests for Pipeline Executor and SPSC Queue APIs
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "perception/argument_parser/cli_options.h"
+#include "perception/inference_engine/interpreter_pool.h"
+#include "perception/inference_engine/pipeline_executor.h"
+#include "perception/utils/spsc_queue.h"
+
+namespace perception
+{
+namespace
+{
+TEST(SpscQueueTest, GivenFullQueue_WhenTryPush_ExpectRejected)
+{
+    SpscQueue<std::int32_t> unit{2U};
+
+    EXPECT_TRUE(unit.TryPush(1));
+    EXPECT_TRUE(unit.TryPush(2));
+    EXPECT_FALSE(unit.TryPush(3));
+    EXPECT_EQ(unit.GetSize(), unit.GetCapacity());
+}
+
+TEST(SpscQueueTest, GivenProducerThread_WhenPop_ExpectAllElementsInOrder)
+{
+    SpscQueue<std::int32_t> unit{3U};
+    std::thread producer{[&]() {
+        for (std::int32_t i = 0; i < 1000; ++i)
+        {
+            unit.Push(i);
+        }
+        unit.Close();
+    }};
+
+    std::vector<std::int32_t> consumed;
+    std::int32_t value = 0;
+    while (unit.Pop(&value))
+    {
+        consumed.push_back(value);
+    }
+    producer.join();
+
+    ASSERT_EQ(consumed.size(), 1000U);
+    for (std::int32_t i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(consumed[i], i);
+    }
+}
+
+TEST(SpscQueueTest, GivenWaitingConsumer_WhenClose_ExpectPopReturnsFalse)
+{
+    SpscQueue<std::int32_t> unit{2U};
+    std::thread closer{[&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        unit.Close();
+    }};
+
+    std::int32_t value = 0;
+    EXPECT_FALSE(unit.Pop(&value));
+    closer.join();
+}
+
+TEST(SpscQueueTest, GivenWaitingProducer_WhenClose_ExpectPushReturnsFalse)
+{
+    SpscQueue<std::int32_t> unit{1U};
+    ASSERT_TRUE(unit.Push(1));
+    std::thread closer{[&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        unit.Close();
+    }};
+
+    EXPECT_FALSE(unit.Push(2));
+    closer.join();
+}
+
+TEST(PipelineExecutorTest, GivenImageStream_WhenRun_ExpectResultsPerFrameInOrder)
+{
+    const CLIOptions cli_options{};
+    InterpreterPool pool{cli_options.model_name, 1U, cli_options.number_of_threads};
+    auto interpreter = pool.Acquire();
+    PipelineExecutor unit{interpreter.get(), cli_options.input_mean, cli_options.input_std,
+                          cli_options.number_of_results, 2U};
+    const std::vector<std::string> image_paths{"data/grace_hopper.bmp", cli_options.input_name,
+                                               "data/grace_hopper.bmp"};
+
+    const auto results = unit.Run(image_paths);
+
+    ASSERT_EQ(results.size(), image_paths.size());
+    for (std::size_t index = 0U; index < results.size(); ++index)
+    {
+        EXPECT_EQ(results[index].frame_index, index);
+        EXPECT_EQ(results[index].results.size(), cli_options.number_of_results);
+    }
+    EXPECT_EQ(results[0].results, results[2].results);
+
+    const auto statistics = unit.GetStageStatistics();
+    ASSERT_EQ(statistics.size(), 4U);
+    for (const auto& stage : statistics)
+    {
+        EXPECT_EQ(stage.frames, image_paths.size());
+        EXPECT_LE(stage.occupancy, 1.0);
+    }
+}
+
+TEST(PipelineExecutorTest, GivenInvalidImagePath_WhenRun_ExpectException)
+{
+    const CLIOptions cli_options{};
+    InterpreterPool pool{cli_options.model_name, 1U, cli_options.number_of_threads};
+    auto interpreter = pool.Acquire();
+    PipelineExecutor unit{interpreter.get(), cli_options.input_mean, cli_options.input_std,
+                          cli_options.number_of_results, 2U};
+
+    EXPECT_ANY_THROW(unit.Run({"data/grace_hopper.bmp", "invalid.bmp"}));
+}
+
+}  // namespace
+}  // namespace perception
@@ -0,0 +1,77 @@
+///
+/// @file preprocessing_engine_test.cpp
+/// @brief Contains unit tests for Preprocessing Engine APIs
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "perception/inference_engine/preprocessing_engine.h"
+
+namespace perception
+{
+namespace
+{
+class PreprocessingEngineTestFixture : public ::testing::Test
+{
+  public:
+    PreprocessingEngineTestFixture()
+        : unit_{127.5F, 127.5F},
+          input_dims_{8, 6, 3},
+          output_dims_{4, 4, 3},
+          input_(input_dims_.height * input_dims_.width * input_dims_.channels, 255U)
+    {
+    }
+
+  protected:
+    PreprocessingEngine unit_;
+    const ImageDimensions input_dims_;
+    const ImageDimensions output_dims_;
+    std::vector<std::uint8_t> input_;
+};
+
+TEST_F(PreprocessingEngineTestFixture, GivenSameShape_WhenResize_ExpectResizeInterpreterReused)
+{
+    std::vector<std::uint8_t> output(output_dims_.height * output_dims_.width * output_dims_.channels);
+
+    unit_.Resize(input_.data(), input_dims_, output_dims_, output.data());
+    unit_.Resize(input_.data(), input_dims_, output_dims_, output.data());
+
+    EXPECT_EQ(unit_.GetCacheSize(), 1U);
+    EXPECT_THAT(output, ::testing::Each(255U));
+}
+
+TEST_F(PreprocessingEngineTestFixture, GivenDifferentShapes_WhenResize_ExpectCachedPerShape)
+{
+    std::vector<std::uint8_t> output(output_dims_.height * output_dims_.width * output_dims_.channels);
+    std::vector<float> float_output(output.size());
+    const ImageDimensions other_input_dims{4, 4, 3};
+
+    unit_.Resize(input_.data(), input_dims_, output_dims_, output.data());
+    unit_.Resize(input_.data(), other_input_dims, output_dims_, output.data());
+    unit_.Resize(input_.data(), input_dims_, output_dims_, float_output.data());
+
+    EXPECT_EQ(unit_.GetCacheSize(), 3U);
+    EXPECT_THAT(float_output, ::testing::Each(::testing::FloatEq(1.0F)));
+}
+
+TEST_F(PreprocessingEngineTestFixture, GivenQuantizationParams_WhenResize_ExpectQuantizedOutput)
+{
+    std::vector<std::uint8_t> uint8_output(output_dims_.height * output_dims_.width * output_dims_.channels);
+    std::vector<std::int8_t> int8_output(uint8_output.size());
+
+    TfLiteQuantizationParams params{};
+    params.scale = 1.0F / 128.0F;
+    params.zero_point = 0;
+    unit_.Resize(input_.data(), input_dims_, output_dims_, params, int8_output.data());
+    params.zero_point = 100;
+    unit_.Resize(input_.data(), input_dims_, output_dims_, params, uint8_output.data());
+
+    EXPECT_THAT(int8_output, ::testing::Each(127));
+    EXPECT_THAT(uint8_output, ::testing::Each(228U));
+}
+
+}  // namespace
+}  // namespace perception
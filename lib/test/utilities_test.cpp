@@ -3,14 +3,41 @@
 /// @brief Contains unit tests for utility functions
 /// @copyright Copyright (c) 2020. All Rights Reserved.
 ///
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "perception/image_helper/bitmap_helper.h"
+#include "perception/image_helper/bitmap_swizzle.h"
 #include "perception/image_helper/i_image_helper.h"
+#include "perception/image_helper/jpeg_color.h"
+#include "perception/image_helper/jpeg_idct.h"
+#include "perception/image_helper/jpeg_helper.h"
+#include "perception/utils/arena.h"
+#include "perception/utils/async_result_writer.h"
 #include "perception/utils/get_top_n.h"
+#include "perception/utils/input_cache.h"
+#include "perception/utils/json.h"
+#include "perception/utils/label_table.h"
+#include "perception/utils/latency_statistics.h"
+#include "perception/utils/mapped_file.h"
+#include "perception/utils/resize_bilinear.h"
+#include "perception/utils/thread_pool.h"
+#include "perception/utils/top_k.h"
 
 namespace perception
 {
@@ -62,6 +89,616 @@ TEST_F(UtilitiesTestFixture, GivenNullImageAttributes_WhenReadImage_ExpectExcept
     EXPECT_THROW(image_helper_->ReadImage(test_image_path_, nullptr, nullptr, nullptr), std::runtime_error);
 }
 
+TEST_F(UtilitiesTestFixture, GivenImagePaths_WhenProbe_ExpectSameSizeAsReadImage)
+{
+    BitmapImageHelper bitmap_helper;
+    JpegImageHelper jpeg_helper;
+    for (const auto& test_case : {std::make_pair(static_cast<IImageHelper*>(&bitmap_helper), "data/grace_hopper.bmp"),
+                                  std::make_pair(static_cast<IImageHelper*>(&jpeg_helper), "data/grace_hopper.jpg")})
+    {
+        const auto info = test_case.first->Probe(test_case.second);
+        test_case.first->ReadImage(test_case.second, &width_, &height_, &channels_);
+
+        EXPECT_EQ(info.format, (test_case.first == &bitmap_helper) ? ImageFormat::kBitmap : ImageFormat::kJpeg);
+        EXPECT_EQ(info.width, width_);
+        EXPECT_EQ(info.height, height_);
+        EXPECT_EQ(info.channels, channels_);
+        EXPECT_GE(info.horizontal_subsampling, 1);
+        EXPECT_GE(info.vertical_subsampling, 1);
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenUnsupportedBitsPerPixel_WhenProbeBitmap_ExpectException)
+{
+    std::ifstream file{"data/grace_hopper.bmp", std::ios::binary};
+    std::string bmp{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    ASSERT_GT(bmp.size(), 30U);
+    // 16 bpp, i.e. neither 8, 24 nor 32
+    bmp[28] = 16;
+    bmp[29] = 0;
+    std::ofstream{"unsupported_bpp.bmp", std::ios::binary} << bmp;
+    BitmapImageHelper bitmap_helper;
+
+    EXPECT_THROW(bitmap_helper.Probe("unsupported_bpp.bmp"), std::runtime_error);
+    EXPECT_THROW(bitmap_helper.ReadImage("unsupported_bpp.bmp", &width_, &height_, &channels_), std::runtime_error);
+}
+
+TEST_F(UtilitiesTestFixture, GivenHugeDimensions_WhenReadBitmap_ExpectException)
+{
+    std::ifstream file{"data/grace_hopper.bmp", std::ios::binary};
+    const std::string bmp{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    ASSERT_GT(bmp.size(), 30U);
+    // width of INT32_MAX, i.e. row size beyond 32 bit
+    std::string huge_width{bmp};
+    huge_width.replace(18U, 4U, std::string{"\xff\xff\xff\x7f", 4U});
+    std::ofstream{"huge_width.bmp", std::ios::binary} << huge_width;
+    // height of INT32_MIN, i.e. number of rows not representable
+    std::string huge_height{bmp};
+    huge_height.replace(22U, 4U, std::string{"\x00\x00\x00\x80", 4U});
+    std::ofstream{"huge_height.bmp", std::ios::binary} << huge_height;
+    BitmapImageHelper bitmap_helper;
+
+    EXPECT_THROW(bitmap_helper.ReadImage("huge_width.bmp", &width_, &height_, &channels_), std::runtime_error);
+    EXPECT_THROW(bitmap_helper.Probe("huge_height.bmp"), std::runtime_error);
+    EXPECT_THROW(bitmap_helper.ReadImage("huge_height.bmp", &width_, &height_, &channels_), std::runtime_error);
+}
+
+TEST_F(UtilitiesTestFixture, GivenFillBytes_WhenProbeJpeg_ExpectSameInfoAsWithout)
+{
+    std::ifstream file{"data/grace_hopper.jpg", std::ios::binary};
+    std::string jpeg{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    auto frame_header = jpeg.find("\xff\xc0");
+    frame_header = (frame_header == std::string::npos) ? jpeg.find("\xff\xc2") : frame_header;
+    ASSERT_NE(frame_header, std::string::npos);
+    // 0xFF fill bytes before the frame header and before the first marker after SOI
+    jpeg.insert(frame_header, "\xff\xff\xff");
+    jpeg.insert(2U, "\xff");
+    std::ofstream{"fill_bytes.jpg", std::ios::binary} << jpeg;
+    JpegImageHelper jpeg_helper;
+
+    const auto expected = jpeg_helper.Probe("data/grace_hopper.jpg");
+    const auto actual = jpeg_helper.Probe("fill_bytes.jpg");
+
+    EXPECT_EQ(actual.width, expected.width);
+    EXPECT_EQ(actual.height, expected.height);
+    EXPECT_EQ(actual.channels, expected.channels);
+    EXPECT_EQ(actual.horizontal_subsampling, expected.horizontal_subsampling);
+    EXPECT_EQ(actual.vertical_subsampling, expected.vertical_subsampling);
+}
+
+TEST_F(UtilitiesTestFixture, GivenFourComponentFrameHeader_WhenProbeJpeg_ExpectException)
+{
+    std::ifstream file{"data/grace_hopper.jpg", std::ios::binary};
+    std::string jpeg{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    auto frame_header = jpeg.find("\xff\xc0");
+    frame_header = (frame_header == std::string::npos) ? jpeg.find("\xff\xc2") : frame_header;
+    ASSERT_NE(frame_header, std::string::npos);
+    // marker, length, precision, height, width, i.e. number of components at offset 9 (4 for CMYK/YCCK)
+    jpeg[frame_header + 9U] = 4;
+    std::ofstream{"four_components.jpg", std::ios::binary} << jpeg;
+    JpegImageHelper jpeg_helper;
+
+    EXPECT_THROW(jpeg_helper.Probe("four_components.jpg"), std::runtime_error);
+    EXPECT_THROW(jpeg_helper.ReadImage("four_components.jpg", &width_, &height_, &channels_), std::runtime_error);
+}
+
+TEST_F(UtilitiesTestFixture, GivenLumaOnly_WhenProbeJpeg_ExpectSingleChannel)
+{
+    JpegImageHelper jpeg_helper;
+    jpeg_helper.SetLumaOnly(true);
+
+    const auto info = jpeg_helper.Probe("data/grace_hopper.jpg");
+    jpeg_helper.ReadImage("data/grace_hopper.jpg", &width_, &height_, &channels_);
+
+    EXPECT_EQ(info.channels, 1);
+    EXPECT_EQ(info.channels, channels_);
+}
+
+TEST_F(UtilitiesTestFixture, GivenNonJpegImagePath_WhenProbe_ExpectException)
+{
+    JpegImageHelper jpeg_helper;
+    EXPECT_THROW(jpeg_helper.Probe("invalid_file"), std::runtime_error);
+    EXPECT_THROW(jpeg_helper.Probe(test_image_path_), std::runtime_error);
+}
+
+TEST_F(UtilitiesTestFixture, GivenOutputBuffer_WhenReadBitmapImage_ExpectSameImageAsReadImage)
+{
+    BitmapImageHelper bitmap_helper;
+    const auto image = bitmap_helper.ReadImage(test_image_path_, &width_, &height_, &channels_);
+
+    std::vector<std::uint8_t> output(image.size());
+    bitmap_helper.ReadImage(test_image_path_, output.data(), output.size(), &width_, &height_, &channels_);
+    EXPECT_EQ(output, image);
+
+    // rejected output buffer leaves the dimensions untouched
+    width_ = height_ = channels_ = -1;
+    EXPECT_THROW(
+        bitmap_helper.ReadImage(test_image_path_, output.data(), output.size() - 1U, &width_, &height_, &channels_),
+        std::runtime_error);
+    EXPECT_EQ(width_, -1);
+    EXPECT_EQ(height_, -1);
+    EXPECT_EQ(channels_, -1);
+}
+
+TEST_F(UtilitiesTestFixture, GivenJpegImagePath_WhenReadImageView_ExpectSameImageAsReadImage)
+{
+    JpegImageHelper jpeg_helper;
+    const auto image = jpeg_helper.ReadImage("data/grace_hopper.jpg", &width_, &height_, &channels_);
+    const auto view = jpeg_helper.ReadImageView("data/grace_hopper.jpg", &width_, &height_, &channels_);
+
+    ASSERT_EQ(height_, test_image_height_);
+    ASSERT_EQ(width_, test_image_width_);
+    ASSERT_EQ(channels_, test_image_channels_);
+    EXPECT_TRUE(std::equal(image.begin(), image.end(), view));
+}
+
+TEST_F(UtilitiesTestFixture, GivenReusedDecoderWithArena_WhenDecode_ExpectSameImageWithoutHeapAllocations)
+{
+    const MappedFile jpeg_file{"data/grace_hopper.jpg"};
+    const auto data = reinterpret_cast<const char*>(jpeg_file.GetData());
+    const Jpeg::Decoder expected{data, jpeg_file.GetSize()};
+    Arena arena;
+    Jpeg::Decoder unit{malloc, free, GetSupportedInstructionSet(), &arena};
+
+    std::size_t heap_allocations = 0U;
+    for (std::int32_t image = 0; image < 3; ++image)
+    {
+        arena.Reset();
+        ASSERT_EQ(unit.Decode(data, jpeg_file.GetSize()), Jpeg::Decoder::OK);
+        if (image == 1)
+        {
+            heap_allocations = arena.GetNumberOfHeapAllocations();
+        }
+
+        ASSERT_EQ(unit.GetImageSize(), expected.GetImageSize());
+        EXPECT_TRUE(std::equal(unit.GetImage(), unit.GetImage() + unit.GetImageSize(), expected.GetImage()));
+    }
+    EXPECT_EQ(arena.GetNumberOfHeapAllocations(), heap_allocations);
+}
+
+TEST_F(UtilitiesTestFixture, GivenDecodeOptions_WhenDecode_ExpectSameImageAsSingleImageDecoder)
+{
+    const MappedFile jpeg_file{"data/grace_hopper.jpg"};
+    const auto data = reinterpret_cast<const char*>(jpeg_file.GetData());
+    Jpeg::Decoder::DecodeOptions options;
+    options.minWidth = 64;
+    options.minHeight = 64;
+    options.cropX = 16;
+    options.cropY = 32;
+    options.cropWidth = 256;
+    options.cropHeight = 192;
+    options.lumaOnly = true;
+    const Jpeg::Decoder expected{data, jpeg_file.GetSize(), malloc, free, GetSupportedInstructionSet(), options};
+    Jpeg::Decoder unit;
+
+    ASSERT_EQ(unit.Decode(data, jpeg_file.GetSize()), Jpeg::Decoder::OK);
+    ASSERT_EQ(unit.Decode(data, jpeg_file.GetSize(), options), Jpeg::Decoder::OK);
+
+    EXPECT_FALSE(unit.IsColor());
+    EXPECT_EQ(unit.GetScaleShift(), 1);
+    EXPECT_EQ(unit.GetWidth(), 128);
+    EXPECT_EQ(unit.GetHeight(), 96);
+    ASSERT_EQ(unit.GetImageSize(), expected.GetImageSize());
+    EXPECT_TRUE(std::equal(unit.GetImage(), unit.GetImage() + unit.GetImageSize(), expected.GetImage()));
+}
+
+TEST_F(UtilitiesTestFixture, GivenMultipleThreads_WhenReadJpegImage_ExpectSameImageAsSerialDecode)
+{
+    JpegImageHelper serial_helper;
+    const auto expected = serial_helper.ReadImage("data/grace_hopper.jpg", &width_, &height_, &channels_);
+
+    JpegImageHelper parallel_helper;
+    parallel_helper.SetNumberOfThreads(4);
+    const auto actual = parallel_helper.ReadImage("data/grace_hopper.jpg", &width_, &height_, &channels_);
+
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(UtilitiesTestFixture, GivenInvalidJpegImagePath_WhenReadImageView_ExpectException)
+{
+    JpegImageHelper jpeg_helper;
+    EXPECT_THROW(jpeg_helper.ReadImageView("invalid_file", &width_, &height_, &channels_), std::runtime_error);
+}
+
+TEST_F(UtilitiesTestFixture, GivenRandomBlocks_WhenInverseDct_ExpectBitExactAcrossInstructionSets)
+{
+    constexpr std::int32_t kStride = 11;
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<std::int32_t> coefficient{-4096, 4096};
+    std::uniform_int_distribution<std::int32_t> sparsity{0, 3};
+    const auto reference = GetInverseDct(InstructionSet::kScalar);
+
+    for (std::int32_t iteration = 0; iteration < 1000; ++iteration)
+    {
+        std::array<std::int32_t, 64> block{};
+        for (auto& value : block)
+        {
+            // mostly zero AC coefficients, as in real images (exercises all-zero row/column shortcuts)
+            value = (sparsity(generator) == 0) ? coefficient(generator) : 0;
+        }
+        auto expected_block = block;
+        std::array<std::uint8_t, 8 * kStride> expected{};
+        reference(expected_block.data(), expected.data(), kStride);
+
+        for (const auto instruction_set : {InstructionSet::kSse2, InstructionSet::kAvx2})
+        {
+            if (instruction_set > GetSupportedInstructionSet())
+            {
+                continue;
+            }
+            auto actual_block = block;
+            std::array<std::uint8_t, 8 * kStride> actual{};
+            GetInverseDct(instruction_set)(actual_block.data(), actual.data(), kStride);
+            ASSERT_EQ(actual, expected) << "instruction set " << static_cast<std::int32_t>(instruction_set);
+        }
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenRandomRows_WhenColorKernels_ExpectBitExactAcrossInstructionSets)
+{
+    // odd width, so that SIMD kernels run their scalar tails too
+    constexpr std::int32_t kWidth = 77;
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<std::int32_t> distribution{0, 255};
+    std::vector<std::vector<std::uint8_t>> rows(4, std::vector<std::uint8_t>(kWidth));
+    for (auto& row : rows)
+    {
+        std::generate(row.begin(), row.end(), [&]() { return static_cast<std::uint8_t>(distribution(generator)); });
+    }
+    const std::uint8_t* row_pointers[4] = {rows[0].data(), rows[1].data(), rows[2].data(), rows[3].data()};
+    const auto taps = GetUpsampleTaps(7, kWidth);
+
+    const auto reference = GetColorKernels(InstructionSet::kScalar);
+    std::vector<std::uint8_t> expected_upsampled(2 * kWidth);
+    std::vector<std::uint8_t> expected_filtered(kWidth);
+    std::vector<std::uint8_t> expected_rgb(3 * kWidth);
+    reference.upsample_row(rows[0].data(), kWidth, expected_upsampled.data());
+    reference.filter_rows(row_pointers, taps.weight, kWidth, expected_filtered.data());
+    reference.convert_row(rows[0].data(), rows[1].data(), rows[2].data(), kWidth, expected_rgb.data());
+
+    for (const auto instruction_set : {InstructionSet::kSse2, InstructionSet::kAvx2})
+    {
+        if (instruction_set > GetSupportedInstructionSet())
+        {
+            continue;
+        }
+        const auto kernels = GetColorKernels(instruction_set);
+        std::vector<std::uint8_t> upsampled(2 * kWidth);
+        std::vector<std::uint8_t> filtered(kWidth);
+        std::vector<std::uint8_t> rgb(3 * kWidth);
+        kernels.upsample_row(rows[0].data(), kWidth, upsampled.data());
+        kernels.filter_rows(row_pointers, taps.weight, kWidth, filtered.data());
+        kernels.convert_row(rows[0].data(), rows[1].data(), rows[2].data(), kWidth, rgb.data());
+
+        EXPECT_EQ(upsampled, expected_upsampled) << "instruction set " << static_cast<std::int32_t>(instruction_set);
+        EXPECT_EQ(filtered, expected_filtered) << "instruction set " << static_cast<std::int32_t>(instruction_set);
+        EXPECT_EQ(rgb, expected_rgb) << "instruction set " << static_cast<std::int32_t>(instruction_set);
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenRandomRows_WhenBitmapKernels_ExpectBitExactAcrossInstructionSets)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<std::int32_t> distribution{0, 255};
+    std::vector<std::uint8_t> row(4 * 77);
+    std::generate(row.begin(), row.end(), [&]() { return static_cast<std::uint8_t>(distribution(generator)); });
+
+    const auto reference = GetBitmapKernels(InstructionSet::kScalar);
+    std::array<std::uint8_t, 4> pixel{};
+    reference.bgra_to_rgba(row.data(), 1, pixel.data());
+    EXPECT_EQ(pixel, (std::array<std::uint8_t, 4>{row[2], row[1], row[0], row[3]}));
+
+    for (const auto instruction_set : {InstructionSet::kSsse3, InstructionSet::kAvx2})
+    {
+        if (instruction_set > GetSupportedInstructionSet())
+        {
+            continue;
+        }
+        const auto kernels = GetBitmapKernels(instruction_set);
+        // widths below, at and beyond the SIMD block sizes, so that scalar tails run too
+        for (const auto width : {1, 5, 6, 8, 11, 16, 77})
+        {
+            std::vector<std::uint8_t> expected_rgb(3 * width);
+            std::vector<std::uint8_t> expected_rgba(4 * width);
+            reference.bgr_to_rgb(row.data(), width, expected_rgb.data());
+            reference.bgra_to_rgba(row.data(), width, expected_rgba.data());
+
+            std::vector<std::uint8_t> rgb(3 * width);
+            std::vector<std::uint8_t> rgba(4 * width);
+            kernels.bgr_to_rgb(row.data(), width, rgb.data());
+            kernels.bgra_to_rgba(row.data(), width, rgba.data());
+
+            EXPECT_EQ(rgb, expected_rgb) << "instruction set " << static_cast<std::int32_t>(instruction_set);
+            EXPECT_EQ(rgba, expected_rgba) << "instruction set " << static_cast<std::int32_t>(instruction_set);
+        }
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenSmoothBlocks_WhenScaledInverseDct_ExpectAveragedFullInverseDct)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<std::int32_t> coefficient{-256, 256};
+    const auto full = GetInverseDct(InstructionSet::kScalar);
+
+    for (std::int32_t iteration = 0; iteration < 100; ++iteration)
+    {
+        // low frequencies only (i.e. what reduced IDCTs keep), without clipping
+        std::array<std::int32_t, 64> block{};
+        block[0] = coefficient(generator) * 2;
+        block[1] = coefficient(generator) / 4;
+        block[8] = coefficient(generator) / 4;
+
+        auto full_block = block;
+        std::array<std::uint8_t, 64> expected{};
+        full(full_block.data(), expected.data(), 8);
+
+        for (std::int32_t scale_shift = 1; scale_shift <= 3; ++scale_shift)
+        {
+            const std::int32_t size = 8 >> scale_shift;
+            const std::int32_t cell = 1 << scale_shift;
+            auto scaled_block = block;
+            std::array<std::uint8_t, 64> actual{};
+            GetScaledInverseDct(scale_shift)(scaled_block.data(), actual.data(), size);
+
+            for (std::int32_t y = 0; y < size; ++y)
+            {
+                for (std::int32_t x = 0; x < size; ++x)
+                {
+                    std::int32_t sum = 0;
+                    for (std::int32_t i = 0; i < cell * cell; ++i)
+                    {
+                        sum += expected[(y * cell + i / cell) * 8 + x * cell + i % cell];
+                    }
+                    ASSERT_NEAR(actual[y * size + x], sum / (cell * cell), 4) << "scale shift " << scale_shift;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenMinimumSize_WhenReadJpegImage_ExpectDownscaledWithinDctDomain)
+{
+    JpegImageHelper jpeg_helper;
+    jpeg_helper.SetMinimumSize(224, 224);
+    const auto image = jpeg_helper.ReadImage("data/grace_hopper.jpg", &width_, &height_, &channels_);
+
+    // 1/4 would be 130x152, thus 1/2 (rounded up)
+    EXPECT_EQ(width_, (test_image_width_ + 1) / 2);
+    EXPECT_EQ(height_, (test_image_height_ + 1) / 2);
+    EXPECT_EQ(channels_, test_image_channels_);
+    EXPECT_EQ(image.size(), static_cast<std::size_t>(width_ * height_ * channels_));
+}
+
+TEST_F(UtilitiesTestFixture, GivenRegionOfInterest_WhenReadImage_ExpectRegionOfWholeImage)
+{
+    BitmapImageHelper bitmap_helper;
+    JpegImageHelper jpeg_helper;
+    for (const auto& test_case : {std::make_pair(static_cast<IImageHelper*>(&bitmap_helper), "data/grace_hopper.bmp"),
+                                  std::make_pair(static_cast<IImageHelper*>(&jpeg_helper), "data/grace_hopper.jpg")})
+    {
+        IImageHelper& image_helper = *test_case.first;
+        const auto image = image_helper.ReadImage(test_case.second, &width_, &height_, &channels_);
+        const auto image_width = width_;
+
+        // exceeds the image on the right, thus clipped
+        image_helper.SetRegionOfInterest(37, 61, image_width, 100);
+        const auto region = image_helper.ReadImage(test_case.second, &width_, &height_, &channels_);
+
+        ASSERT_EQ(width_, image_width - 37);
+        ASSERT_EQ(height_, 100);
+        ASSERT_EQ(region.size(), static_cast<std::size_t>(width_ * height_ * channels_));
+        for (std::int32_t row = 0; row < height_; ++row)
+        {
+            EXPECT_TRUE(std::equal(region.begin() + row * width_ * channels_,
+                                   region.begin() + (row + 1) * width_ * channels_,
+                                   image.begin() + ((61 + row) * image_width + 37) * channels_));
+        }
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenLumaOnly_WhenReadJpegImage_ExpectLumaOfColorImage)
+{
+    JpegImageHelper jpeg_helper;
+    const auto image = jpeg_helper.ReadImage("data/grace_hopper.jpg", &width_, &height_, &channels_);
+    ASSERT_EQ(channels_, 3);
+
+    jpeg_helper.SetLumaOnly(true);
+    const auto luma = jpeg_helper.ReadImage("data/grace_hopper.jpg", &width_, &height_, &channels_);
+
+    EXPECT_EQ(width_, test_image_width_);
+    EXPECT_EQ(height_, test_image_height_);
+    ASSERT_EQ(channels_, 1);
+    ASSERT_EQ(luma.size(), static_cast<std::size_t>(width_ * height_));
+    // Y plane vs. BT.601 luma of RGB, which only differs by rounding (and clipping of saturated colors)
+    double error = 0.0;
+    for (std::size_t index = 0U; index < luma.size(); ++index)
+    {
+        const auto expected =
+            0.299 * image[3 * index] + 0.587 * image[3 * index + 1] + 0.114 * image[3 * index + 2];
+        error += std::abs(expected - luma[index]);
+    }
+    EXPECT_LT(error / luma.size(), 1.0);
+}
+
+TEST_F(UtilitiesTestFixture, GivenExhaustedArena_WhenReset_ExpectBlockFittingAllAllocations)
+{
+    Arena unit;
+    for (std::int32_t cycle = 0; cycle < 3; ++cycle)
+    {
+        unit.Reset();
+        for (const auto size : {100U, 1U, 5000U, 64U})
+        {
+            const auto buffer = unit.Allocate(size);
+            ASSERT_NE(buffer, nullptr);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % Arena::kAlignment, 0U);
+            std::fill_n(static_cast<std::uint8_t*>(buffer), size, 0xFF);
+        }
+    }
+
+    // first cycle falls back to heap (4), second one grows the block (1) and uses it from then on
+    EXPECT_EQ(unit.GetCapacity(), 128U + 64U + 5056U + 64U);
+    EXPECT_EQ(unit.GetNumberOfHeapAllocations(), 5U);
+}
+
+TEST_F(UtilitiesTestFixture, GivenFullInputCache_WhenInsert_ExpectLeastRecentlyUsedEvicted)
+{
+    InputCache unit{300U};
+    const auto first = InputCache::MakeKey("data/grace_hopper.jpg", {1, 224, 224, 3}, 3);
+    auto second = first;
+    second.shape = {1, 128, 128, 3};
+    auto third = first;
+    third.modification_time += 1;
+    const std::vector<std::uint8_t> data(100U, 42U);
+
+    unit.Insert(first, data.data(), data.size());
+    unit.Insert(second, data.data(), data.size());
+    ASSERT_NE(unit.Find(first), nullptr);
+    unit.Insert(third, data.data(), 200U);
+
+    // second was least recently used
+    EXPECT_EQ(unit.GetNumberOfEntries(), 2U);
+    EXPECT_EQ(unit.GetSize(), 300U);
+    EXPECT_EQ(unit.Find(second), nullptr);
+    ASSERT_NE(unit.Find(first), nullptr);
+    EXPECT_EQ(*unit.Find(first), data);
+    EXPECT_NE(unit.Find(third), nullptr);
+    EXPECT_EQ(unit.GetNumberOfHits(), 4U);
+    EXPECT_EQ(unit.GetNumberOfMisses(), 1U);
+
+    // larger than capacity, i.e. not cached (and nothing evicted)
+    std::vector<std::uint8_t> large(301U);
+    unit.Insert(second, large.data(), large.size());
+    EXPECT_EQ(unit.GetNumberOfEntries(), 2U);
+    EXPECT_EQ(unit.Find(second), nullptr);
+}
+
+TEST_F(UtilitiesTestFixture, GivenDisabledInputCache_WhenInsert_ExpectNothingCached)
+{
+    InputCache unit{0U};
+    const auto key = InputCache::MakeKey("data/grace_hopper.jpg", {1, 224, 224, 3}, 3);
+    const std::vector<std::uint8_t> data(100U);
+    unit.Insert(key, data.data(), data.size());
+
+    EXPECT_FALSE(unit.IsEnabled());
+    EXPECT_EQ(unit.Find(key), nullptr);
+}
+
+TEST_F(UtilitiesTestFixture, GivenTextLabelFile_WhenLoadLabelTable_ExpectLabelsPerLine)
+{
+    std::vector<std::string> expected;
+    std::ifstream file{"data/labels.txt"};
+    for (std::string line; std::getline(file, line);)
+    {
+        expected.push_back(line);
+    }
+
+    const auto unit = LabelTable::Load("data/labels.txt");
+
+    ASSERT_EQ(unit.GetSize(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(unit.Get(i), expected[i]);
+    }
+    EXPECT_TRUE(unit.Get(expected.size()).empty());
+}
+
+TEST_F(UtilitiesTestFixture, GivenSavedLabelTable_WhenLoadBinaryLabelFile_ExpectSameLabels)
+{
+    const auto expected = LabelTable::Load("data/labels.txt");
+    expected.Save("labels.bin");
+
+    const auto unit = LabelTable::Load("labels.bin");
+
+    ASSERT_EQ(unit.GetSize(), expected.GetSize());
+    for (std::size_t i = 0; i <= expected.GetSize(); ++i)
+    {
+        EXPECT_EQ(unit.Get(i), expected.Get(i));
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenTruncatedBinaryLabelFile_WhenLoadLabelTable_ExpectException)
+{
+    std::ofstream{"truncated_labels.bin", std::ios::binary} << "LBL1" << std::string(4U, '\xFF');
+    EXPECT_THROW(LabelTable::Load("truncated_labels.bin"), std::runtime_error);
+}
+
+TEST_F(UtilitiesTestFixture, GivenSubmittedRecords_WhenClose_ExpectAllAppendedInOrder)
+{
+    std::string expected;
+    {
+        AsyncResultWriter unit{"async_results.txt", 4U};
+        for (std::int32_t i = 0; i < 100; ++i)
+        {
+            unit.Submit("record " + std::to_string(i), std::to_string(i));
+            expected += "### record " + std::to_string(i) + "\n" + std::to_string(i) + "\n";
+        }
+        unit.Flush();
+        EXPECT_EQ(unit.GetNumberOfRecords(), 100U);
+        EXPECT_LE(unit.GetNumberOfBatches(), 100U);
+
+        unit.Close();
+        EXPECT_THROW(unit.Submit("record 100", "100"), std::runtime_error);
+    }
+
+    std::ifstream file{"async_results.txt"};
+    const std::string actual{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(UtilitiesTestFixture, GivenInvalidPath_WhenCreateAsyncResultWriter_ExpectException)
+{
+    EXPECT_THROW(AsyncResultWriter("invalid/async_results.txt", 4U), std::runtime_error);
+}
+
+TEST_F(UtilitiesTestFixture, GivenFailingWrite_WhenFlush_ExpectException)
+{
+    // writes to /dev/full fail with ENOSPC
+    AsyncResultWriter unit{"/dev/full", 4U};
+    unit.Submit("record 0", "0");
+
+    EXPECT_THROW(unit.Flush(), std::runtime_error);
+    EXPECT_THROW(unit.Close(), std::runtime_error);
+}
+
+TEST_F(UtilitiesTestFixture, GivenSpecialCharacters_WhenWriteJsonString_ExpectEscapedString)
+{
+    std::stringstream stream;
+
+    WriteJsonString(stream, std::string{"data\\\"images\"\n\t\x01/a.jpg"});
+
+    EXPECT_EQ(stream.str(), "\"data\\\\\\\"images\\\"\\n\\t\\u0001/a.jpg\"");
+}
+
+TEST_F(UtilitiesTestFixture, GivenThreadPool_WhenParallelFor_ExpectEachIndexRunOnce)
+{
+    ThreadPool unit{4U};
+    std::vector<std::atomic<std::int32_t>> calls(1000);
+
+    for (std::int32_t repetition = 0; repetition < 10; ++repetition)
+    {
+        unit.ParallelFor(calls.size(), [&](const std::size_t index) { ++calls[index]; });
+    }
+
+    EXPECT_EQ(unit.GetSize(), 4U);
+    for (const auto& count : calls)
+    {
+        EXPECT_EQ(count.load(), 10);
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenThrowingTask_WhenParallelFor_ExpectException)
+{
+    ThreadPool unit{2U};
+    EXPECT_THROW(unit.ParallelFor(10U,
+                                  [](const std::size_t index) {
+                                      if (index == 5U)
+                                      {
+                                          throw std::runtime_error("task failed");
+                                      }
+                                  }),
+                 std::runtime_error);
+}
+
 TEST_F(UtilitiesTestFixture, GetTopN)
 {
     std::vector<std::uint8_t> in{1, 1, 2, 2, 4, 4, 16, 32, 128, 64};
@@ -72,4 +709,202 @@ TEST_F(UtilitiesTestFixture, GetTopN)
     ASSERT_EQ(top_results[0].second, 8);
 }
 
+TEST_F(UtilitiesTestFixture, GivenQuantizedScores_WhenGetTopK_ExpectSameResultsAsDequantizedGetTopN)
+{
+    // few distinct values, i.e. plenty of ties, and size not a multiple of SIMD blocks
+    constexpr std::int32_t kSize = 20001;
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<std::int32_t> distribution{0, 40};
+    std::vector<std::uint8_t> uint8_scores(kSize);
+    std::vector<std::int8_t> int8_scores(kSize);
+    std::vector<float> uint8_dequantized(kSize);
+    std::vector<float> int8_dequantized(kSize);
+    for (std::int32_t i = 0; i < kSize; ++i)
+    {
+        uint8_scores[i] = static_cast<std::uint8_t>(distribution(generator) * 6);
+        int8_scores[i] = static_cast<std::int8_t>(uint8_scores[i] - 128);
+        uint8_dequantized[i] = (uint8_scores[i] - 3) * 0.00390625F;
+        int8_dequantized[i] = (int8_scores[i] + 128) * 0.00390625F;
+    }
+
+    for (const std::size_t k : {1U, 5U, 64U})
+    {
+        for (const float threshold : {0.001F, 0.5F, 2.0F})
+        {
+            TopKResults expected_uint8;
+            TopKResults expected_int8;
+            get_top_n<float>(uint8_dequantized.data(), kSize, k, threshold, &expected_uint8, true);
+            get_top_n<float>(int8_dequantized.data(), kSize, k, threshold, &expected_int8, true);
+
+            for (const auto instruction_set : {InstructionSet::kScalar, InstructionSet::kSse2, InstructionSet::kAvx2})
+            {
+                if (instruction_set > GetSupportedInstructionSet())
+                {
+                    continue;
+                }
+                EXPECT_EQ(GetTopK(uint8_scores.data(), kSize, k, threshold, 0.00390625F, 3, instruction_set),
+                          expected_uint8)
+                    << "instruction set " << static_cast<std::int32_t>(instruction_set) << ", k " << k;
+                EXPECT_EQ(GetTopK(int8_scores.data(), kSize, k, threshold, 0.00390625F, -128, instruction_set),
+                          expected_int8)
+                    << "instruction set " << static_cast<std::int32_t>(instruction_set) << ", k " << k;
+                EXPECT_EQ(GetTopK(uint8_dequantized.data(), kSize, k, threshold, instruction_set), expected_uint8)
+                    << "instruction set " << static_cast<std::int32_t>(instruction_set) << ", k " << k;
+            }
+        }
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenUint8ScoresWithoutQuantizationParams_WhenGetTopK_ExpectSameResultsAsGetTopN)
+{
+    std::vector<std::uint8_t> in{1, 1, 2, 2, 4, 4, 16, 32, 128, 64};
+
+    std::vector<std::pair<float, std::int32_t>> expected;
+    get_top_n<std::uint8_t>(in.data(), 10, 5, 0.025, &expected, false);
+    EXPECT_EQ(GetTopK(in.data(), 10, 5, 0.025F, 0.0F, 0), expected);
+}
+
+TEST_F(UtilitiesTestFixture, GivenSameSize_WhenResizeBilinear_ExpectIdenticalImage)
+{
+    std::vector<std::uint8_t> in(test_image_height_ * test_image_width_ * test_image_channels_);
+    std::iota(in.begin(), in.end(), 0U);
+    std::vector<std::uint8_t> out(in.size());
+
+    BilinearResizer unit{test_image_height_, test_image_width_, test_image_channels_,
+                         test_image_height_, test_image_width_, test_image_channels_};
+    unit.Resize(in.data(), out.data());
+
+    EXPECT_EQ(in, out);
+}
+
+TEST_F(UtilitiesTestFixture, GivenUniformImage_WhenResizeBilinearWithNormalization_ExpectNormalizedImage)
+{
+    std::vector<std::uint8_t> in(test_image_height_ * test_image_width_ * test_image_channels_, 255U);
+    std::vector<float> out(height_ * width_ * channels_);
+
+    BilinearResizer unit{test_image_height_, test_image_width_, test_image_channels_, height_, width_, channels_};
+    unit.Resize(in.data(), 1.0F / 127.5F, -127.5F / 127.5F, out.data());
+
+    for (const auto value : out)
+    {
+        EXPECT_FLOAT_EQ(value, 1.0F);
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenAllInstructionSets_WhenResizeBilinear_ExpectSameResults)
+{
+    std::mt19937 generator{0U};
+    std::uniform_int_distribution<std::int32_t> distribution{0, 255};
+    std::vector<std::uint8_t> in(test_image_height_ * test_image_width_ * test_image_channels_);
+    std::generate(in.begin(), in.end(), [&]() { return static_cast<std::uint8_t>(distribution(generator)); });
+
+    std::vector<float> expected(height_ * width_ * channels_);
+    BilinearResizer scalar{test_image_height_, test_image_width_, test_image_channels_, height_,
+                           width_,             channels_,         InstructionSet::kScalar};
+    scalar.Resize(in.data(), 1.0F / 127.5F, -127.5F / 127.5F, expected.data());
+
+    for (const auto instruction_set : {InstructionSet::kSse41, InstructionSet::kAvx2})
+    {
+        if (instruction_set > GetSupportedInstructionSet())
+        {
+            continue;
+        }
+        std::vector<float> actual(expected.size());
+        BilinearResizer unit{test_image_height_, test_image_width_, test_image_channels_, height_,
+                             width_,             channels_,         instruction_set};
+        unit.Resize(in.data(), 1.0F / 127.5F, -127.5F / 127.5F, actual.data());
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            ASSERT_NEAR(actual[i], expected[i], 1e-5F);
+        }
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenRGBImage_WhenResizeBilinearToSingleChannel_ExpectLuma)
+{
+    std::vector<std::uint8_t> in(test_image_height_ * test_image_width_ * test_image_channels_, 0U);
+    for (std::size_t i = 0; i < in.size(); i += test_image_channels_)
+    {
+        in[i + 1] = 200U;
+    }
+    std::vector<std::uint8_t> out(height_ * width_);
+
+    BilinearResizer unit{test_image_height_, test_image_width_, test_image_channels_, height_, width_, 1};
+    unit.Resize(in.data(), out.data());
+
+    EXPECT_EQ(out.front(), 117U);
+    EXPECT_EQ(out.back(), 117U);
+}
+
+TEST_F(UtilitiesTestFixture, GivenAllInstructionSets_WhenResizeBilinearFixedPoint_ExpectWithinOneOfFloat)
+{
+    std::mt19937 generator{0U};
+    std::uniform_int_distribution<std::int32_t> distribution{0, 255};
+    std::vector<std::uint8_t> in(test_image_height_ * test_image_width_ * test_image_channels_);
+    std::generate(in.begin(), in.end(), [&]() { return static_cast<std::uint8_t>(distribution(generator)); });
+
+    std::vector<float> expected(height_ * width_ * channels_);
+    BilinearResizer reference{test_image_height_, test_image_width_, test_image_channels_, height_,
+                              width_,             channels_,         InstructionSet::kScalar};
+    reference.Resize(in.data(), 1.0F, 0.0F, expected.data());
+
+    for (const auto instruction_set : {InstructionSet::kScalar, InstructionSet::kSse2, InstructionSet::kAvx2})
+    {
+        if (instruction_set > GetSupportedInstructionSet())
+        {
+            continue;
+        }
+        std::vector<std::uint8_t> actual(expected.size());
+        BilinearResizer unit{test_image_height_, test_image_width_, test_image_channels_, height_,
+                             width_,             channels_,         instruction_set};
+        unit.Resize(in.data(), actual.data());
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            ASSERT_NEAR(actual[i], expected[i], 1.0F);
+        }
+    }
+}
+
+TEST_F(UtilitiesTestFixture, GivenQuantizationParams_WhenCreateQuantizationTable_ExpectQuantizedValues)
+{
+    std::uint8_t uint8_table[256];
+    CreateQuantizationTable(127.5F, 127.5F, 1.0F / 128.0F, 128, uint8_table);
+    EXPECT_EQ(uint8_table[0], 0U);
+    EXPECT_EQ(uint8_table[128], 129U);
+    EXPECT_EQ(uint8_table[255], 255U);
+
+    std::int8_t int8_table[256];
+    CreateQuantizationTable(127.5F, 127.5F, 1.0F / 128.0F, 0, int8_table);
+    EXPECT_EQ(int8_table[0], -128);
+    EXPECT_EQ(int8_table[255], 127);
+
+    CreateQuantizationTable(127.5F, 127.5F, 0.0F, 0, int8_table);
+    EXPECT_EQ(int8_table[0], -128);
+    EXPECT_EQ(int8_table[200], 72);
+}
+
+TEST_F(UtilitiesTestFixture, GivenUnmappableChannels_WhenCreateBilinearResizer_ExpectException)
+{
+    EXPECT_THROW(BilinearResizer(test_image_height_, test_image_width_, 3, height_, width_, 4), std::runtime_error);
+}
+
+TEST_F(UtilitiesTestFixture, GivenLatencySamples_WhenSummarized_ExpectPercentilesAndHistogram)
+{
+    LatencyStatistics unit;
+    for (std::int32_t sample = 100; sample >= 1; --sample)
+    {
+        unit.Add(sample);
+    }
+
+    EXPECT_EQ(unit.GetCount(), 100U);
+    EXPECT_DOUBLE_EQ(unit.GetMin(), 1.0);
+    EXPECT_DOUBLE_EQ(unit.GetMean(), 50.5);
+    EXPECT_DOUBLE_EQ(unit.GetPercentile(50.0), 50.0);
+    EXPECT_DOUBLE_EQ(unit.GetPercentile(90.0), 90.0);
+    EXPECT_DOUBLE_EQ(unit.GetPercentile(99.0), 99.0);
+    EXPECT_DOUBLE_EQ(unit.GetMax(), 100.0);
+    EXPECT_THAT(unit.GetHistogram(4U), ::testing::ElementsAre(25U, 25U, 25U, 25U));
+    EXPECT_THAT(unit.ToJson(4U), ::testing::HasSubstr("\"p99_ms\": 99"));
+}
+
 }  // namespace perception
@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+##
+## Compiles text label file (one label per line) into binary label file, which label_image memory maps and uses in
+## place (see lib/include/perception/utils/label_table.h for the layout).
+##
+## Usage: label_table_compiler.py <labels.txt> <labels.bin>
+##
+import struct
+import sys
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.exit('Usage: {} <labels.txt> <labels.bin>'.format(argv[0]))
+
+    with open(argv[1], 'rb') as f:
+        labels = f.read().split(b'\n')
+    # same as std::getline, i.e. trailing line break does not add an empty label
+    if labels[-1] == b'':
+        labels.pop()
+
+    offsets = [0]
+    for label in labels:
+        offsets.append(offsets[-1] + len(label))
+
+    with open(argv[2], 'wb') as f:
+        f.write(b'LBL1')
+        f.write(struct.pack('=I', len(labels)))
+        f.write(struct.pack('={}I'.format(len(offsets)), *offsets))
+        f.write(b''.join(labels))
+
+
+if __name__ == '__main__':
+    main(sys.argv)
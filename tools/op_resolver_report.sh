@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+##
+## Reports binary size and cold-start time of label_image linked with the full (builtin) op resolver against the
+## one linked with the reduced (model specific) op resolver.
+##
+## Usage: op_resolver_report.sh <full_binary> <reduced_binary> <model.tflite> [runs]
+##
+set -euo pipefail
+
+FULL_BINARY="$1"
+REDUCED_BINARY="$2"
+MODEL="$3"
+RUNS="${4:-5}"
+
+## Provides binary size (bytes)
+binary_size() {
+    stat -L -c %s "$1"
+}
+
+## Provides average wall time (ms) of process start to exit (i.e. model load, interpreter build and single invoke)
+cold_start_time() {
+    local binary="$1"
+    local total=0
+    for _ in $(seq "${RUNS}"); do
+        local start end
+        start=$(date +%s%N)
+        "${binary}" --tflite_model "${MODEL}" --count 1 >/dev/null 2>&1
+        end=$(date +%s%N)
+        total=$((total + (end - start) / 1000000))
+    done
+    echo $((total / RUNS))
+}
+
+FULL_SIZE=$(binary_size "${FULL_BINARY}")
+REDUCED_SIZE=$(binary_size "${REDUCED_BINARY}")
+FULL_TIME=$(cold_start_time "${FULL_BINARY}")
+REDUCED_TIME=$(cold_start_time "${REDUCED_BINARY}")
+
+printf "%-10s %15s %15s %15s\n" "" "full" "reduced" "delta"
+printf "%-10s %15s %15s %15s\n" "size (B)" "${FULL_SIZE}" "${REDUCED_SIZE}" "$((REDUCED_SIZE - FULL_SIZE))"
+printf "%-10s %15s %15s %15s\n" "start (ms)" "${FULL_TIME}" "${REDUCED_TIME}" "$((REDUCED_TIME - FULL_TIME))"